@@ -0,0 +1,84 @@
+/*!
+ * @brief   Minimal Arduino and Wire API for host builds, on top of the TMP117 bus simulation
+ *
+ * @license MIT License (see license.txt)
+ */
+
+#include <stdio.h>
+#include "Arduino.h"
+#include "Wire.h"
+#include "TMP117Sim.h"
+
+HostSerial SerialUSB;
+TwoWire Wire;
+
+uint32_t millis(void) {
+  TMP117Sim::tick();
+  return TMP117Sim::time() / 1000;
+}
+
+uint32_t micros(void) {
+  TMP117Sim::tick();
+  return TMP117Sim::time();
+}
+
+void delay(uint32_t ms) {
+  TMP117Sim::advance((uint64_t)ms * 1000);
+}
+
+void pinMode(uint32_t, uint32_t) {}
+void digitalWrite(uint32_t, uint32_t) {}
+void noInterrupts(void) {}
+void interrupts(void) {}
+
+void attachInterrupt(uint32_t pin, void (*isr)(void), uint32_t) {
+  TMP117Sim::attach(pin, isr);
+}
+
+void detachInterrupt(uint32_t pin) {
+  TMP117Sim::attach(pin, nullptr);
+}
+
+size_t HostSerial::print(const char *s) {
+  return fputs(s, stdout) < 0 ? 0 : strlen(s);
+}
+
+size_t HostSerial::print(char c) {
+  return putchar(c) < 0 ? 0 : 1;
+}
+
+size_t HostSerial::print(long n, int base) {
+  return base == DEC ? printf("%ld", n) : print((unsigned long)n, base);
+}
+
+size_t HostSerial::print(unsigned long n, int base) {
+  return printf(base == HEX ? "%lX" : "%lu", n);
+}
+
+size_t HostSerial::print(double d, int digits) {
+  return printf("%.*f", digits, d);
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  address_ = address;
+  txLength_ = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (txLength_ >= sizeof(tx_))
+    return 0;
+  tx_[txLength_++] = data;
+  return 1;
+}
+
+uint8_t TwoWire::endTransmission(bool) {
+  return TMP117Sim::write(address_, tx_, txLength_) ? 0 : 2; // 2: address NACK
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  if (quantity > sizeof(rx_))
+    quantity = sizeof(rx_);
+  rxPos_ = 0;
+  rxLength_ = TMP117Sim::read(address, rx_, quantity) ? quantity : 0;
+  return rxLength_;
+}
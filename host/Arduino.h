@@ -0,0 +1,58 @@
+/**
+ * @file Arduino.h
+ *
+ * @brief Minimal Arduino API for host builds - virtual time, pin interrupts and SerialUSB on stdout
+ *
+ * Time is simulated by TMP117Sim: it advances with I2C traffic, delay() and sleeping, and by 1µs on each
+ * millis()/micros() call, so busy-wait loops make progress.
+ */
+#ifndef _HOST_ARDUINO_H_
+#define _HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define INPUT                   0x0
+#define OUTPUT                  0x1
+#define LOW                     0x0
+#define HIGH                    0x1
+#define FALLING                 0x3
+#define DEC                     10
+#define HEX                     16
+#define BIN                     2
+#define PIN_A8                  8
+#define PIN_A9                  9
+#define PIN_A10                 10
+#define PIN_A11                 11
+#define LED_BLUE                13
+
+uint32_t  millis(void);
+uint32_t  micros(void);
+void      delay(uint32_t ms);
+void      pinMode(uint32_t pin, uint32_t mode);
+void      digitalWrite(uint32_t pin, uint32_t value);
+void      attachInterrupt(uint32_t pin, void (*isr)(void), uint32_t mode);
+void      detachInterrupt(uint32_t pin);
+void      noInterrupts(void);
+void      interrupts(void);
+
+class HostSerial {
+
+  public:
+    void      begin(unsigned long) {}
+              operator bool() const { return true; }
+    size_t    print(const char *s);
+    size_t    print(char c);
+    size_t    print(long n, int base = DEC);
+    size_t    print(unsigned long n, int base = DEC);
+    size_t    print(int n, int base = DEC) { return print((long)n, base); }
+    size_t    print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t    print(double d, int digits = 2);
+    size_t    println(void) { return print("\n"); }
+    template <typename T> size_t println(T v) { return print(v) + println(); }
+    template <typename T> size_t println(T v, int f) { return print(v, f) + println(); }
+};
+
+extern HostSerial SerialUSB;
+#endif
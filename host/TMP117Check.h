@@ -0,0 +1,47 @@
+/**
+ * @file TMP117Check.h
+ *
+ * @brief Pass/fail reporting for the host tests and benchmarks
+ *
+ *   check(duration >= 125, "sweep waits for the conversion");
+ *   ...
+ *   return checkResult();                 // prints "passed" or "<n> FAILED", exit code
+ */
+#ifndef _TMP117_CHECK_H_
+#define _TMP117_CHECK_H_
+
+#include <stdio.h>
+#include <stdarg.h>
+
+static int checkFailures;
+
+/**
+ * @brief Count a failure and print "FAIL: <what>" unless ok
+ *
+ * @param ok Condition that must hold
+ * @param what printf format describing the condition
+ * @returns ok
+ */
+static inline bool check(bool ok, const char *what, ...) {
+  if (!ok) {
+    va_list args;
+    va_start(args, what);
+    printf("FAIL: ");
+    vprintf(what, args);
+    printf("\n");
+    va_end(args);
+    checkFailures++;
+  }
+  return ok;
+}
+
+/**
+ * @brief Print the result
+ *
+ * @returns Exit code: 0 when all checks passed
+ */
+static inline int checkResult(void) {
+  printf(checkFailures ? "%d FAILED\n" : "passed\n", checkFailures);
+  return checkFailures != 0;
+}
+#endif
@@ -0,0 +1,332 @@
+/*!
+ * @brief   Simulated TMP117 devices on a simulated I2C bus
+ *
+ * @license MIT License (see license.txt)
+ */
+
+#include <math.h>
+#include "TMP117Sim.h"
+
+// register map
+enum { temp_r, conf_r, thl_r, tll_r, eep_ul_r, eep1_r, eep2_r, t_offset_r, eep3_r, id_r = 15 };
+
+// config register fields
+#define CONF_HIGH_ALERT         0x8000
+#define CONF_LOW_ALERT          0x4000
+#define CONF_DATA_READY         0x2000
+#define CONF_EEPROM_BUSY        0x1000
+#define CONF_MOD                0x0C00
+#define CONF_CONV               0x0380
+#define CONF_AVG                0x0060
+#define CONF_THERM              0x0010
+#define CONF_DRDY               0x0004
+#define CONF_SOFT_RESET         0x0002
+#define CONF_FLAGS              0xF000
+
+#define MOD_SHUTDOWN            0x0400
+#define MOD_ONE_SHOT            0x0C00
+
+#define EEPROM_PROG_TIME        7000   // [µs]
+#define RESET_TIME              1500
+#define I2C_BYTE_TIME           90     // 9 bits at 100kHz [µs]
+
+TMP117Sim * TMP117Sim::devices_[TMP117_SIM_DEVICES];
+uint8_t TMP117Sim::deviceCount_;
+uint64_t TMP117Sim::now_;
+uint32_t TMP117Sim::transactions_;
+void (*TMP117Sim::isr_[64])(void);
+bool TMP117Sim::inIsr_;
+bool TMP117Sim::pending_[64];
+
+/**
+ * @brief Constructor - device in its factory POR state (continuous conversions, 1s cycle, 8 averages)
+ */
+TMP117Sim::TMP117Sim(uint8_t address, uint8_t alertPin, double (*temperature)(double), double noise) :
+                     address_(address), alertPin_(alertPin & 63), temperature_(temperature), noise_(noise) {
+  for (uint8_t i = 0; i < 16; i++)
+    eeprom_[i] = 0;
+  eeprom_[conf_r] = 0x0220;
+  eeprom_[thl_r] = 0x6000;
+  eeprom_[tll_r] = 0x8000;
+  pin_ = false;
+  late_ = 0;
+  conversions_ = alerts_ = 0;
+  random_ = 0x9E3779B97F4A7C15ull ^ address;
+  busyUntil_ = 0;
+  reset();
+  if (deviceCount_ < TMP117_SIM_DEVICES)
+    devices_[deviceCount_++] = this;
+}
+
+/**
+ * @brief Run the simulation
+ *
+ * @param us Time to advance [µs]
+ */
+void TMP117Sim::advance(uint64_t us) {
+  run(now_ + us, false);
+}
+
+/**
+ * @brief Run the simulation until a time or until an interrupt is delivered
+ *
+ * @param until Time [µs]
+ * @returns True when interrupted
+ */
+bool TMP117Sim::sleep(uint64_t until) {
+  return run(until, true);
+}
+
+/**
+ * @brief Process conversions in time order, deliver Alert interrupts
+ */
+bool TMP117Sim::run(uint64_t until, bool stopOnInterrupt) {
+  while (true) {
+    TMP117Sim * next = nullptr;
+    for (uint8_t i = 0; i < deviceCount_; i++)
+      if (devices_[i]->converting_ && devices_[i]->done_ <= until && (next == nullptr || devices_[i]->done_ < next->done_))
+        next = devices_[i];
+    if (next == nullptr)
+      break;
+    if (next->done_ > now_)
+      now_ = next->done_;
+    next->convert();
+    if (deliver() && stopOnInterrupt)
+      return true;
+  }
+  if (until > now_)
+    now_ = until;
+  return deliver() && stopOnInterrupt;
+}
+
+/**
+ * @brief Call the ISRs of pins with a pending falling edge (not nested)
+ *
+ * @returns True when an ISR was called
+ */
+bool TMP117Sim::deliver(void) {
+  bool called = false;
+  if (inIsr_)
+    return false;
+  for (uint8_t pin = 0; pin < 64; pin++)
+    if (pending_[pin]) {
+      pending_[pin] = false;
+      if (isr_[pin] != nullptr) {
+        inIsr_ = true;
+        isr_[pin]();
+        inIsr_ = false;
+        called = true;
+      }
+    }
+  return called;
+}
+
+void TMP117Sim::attach(uint8_t pin, void (*isr)(void)) {
+  isr_[pin & 63] = isr;
+  pending_[pin & 63] = false;
+}
+
+TMP117Sim * TMP117Sim::find(uint8_t address) {
+  for (uint8_t i = 0; i < deviceCount_; i++)
+    if (devices_[i]->address_ == address)
+      return devices_[i];
+  return nullptr;
+}
+
+/**
+ * @brief I2C write transaction: register pointer, optionally followed by register data; general-call reset
+ *
+ * @returns Acknowledged
+ */
+bool TMP117Sim::write(uint8_t address, const uint8_t *data, uint8_t length) {
+  transactions_++;
+  advance((uint64_t)(length + 1) * I2C_BYTE_TIME);
+
+  if (address == 0x00) { // general call
+    if (length && data[0] == 0x06)
+      for (uint8_t i = 0; i < deviceCount_; i++)
+        devices_[i]->reset();
+    return true;
+  }
+  TMP117Sim * d = find(address);
+  if (d == nullptr || length == 0)
+    return false;
+  d->pointer_ = data[0] & 15;
+  if (length >= 3)
+    d->writeReg(d->pointer_, data[1] << 8 | data[2]);
+  return true;
+}
+
+/**
+ * @brief I2C read transaction from the register pointer
+ *
+ * @returns Acknowledged
+ */
+bool TMP117Sim::read(uint8_t address, uint8_t *data, uint8_t length) {
+  transactions_++;
+  advance((uint64_t)(length + 1) * I2C_BYTE_TIME);
+
+  TMP117Sim * d = find(address);
+  if (d == nullptr)
+    return false;
+  uint16_t v = d->readReg(d->pointer_);
+  for (uint8_t i = 0; i < length; i++)
+    data[i] = i == 0 ? v >> 8 : i == 1 ? v & 0xff : 0;
+  return true;
+}
+
+/**
+ * @brief Reload registers from EEPROM (power-up, soft reset, general-call reset)
+ */
+void TMP117Sim::reset(void) {
+  for (uint8_t i = 0; i < 16; i++)
+    reg_[i] = eeprom_[i];
+  reg_[temp_r] = 0x8000;
+  reg_[conf_r] &= ~CONF_FLAGS;
+  reg_[id_r] = 0x0117;
+  pointer_ = 0;
+  unlocked_ = false;
+  busyUntil_ = now_ + RESET_TIME;
+  converting_ = false;
+  startConversions();
+  updatePin();
+}
+
+void TMP117Sim::startConversions(void) {
+  uint16_t mod = reg_[conf_r] & CONF_MOD;
+  converting_ = mod != MOD_SHUTDOWN;
+  done_ = now_ + conversionTime() + late_;
+}
+
+/**
+ * @brief Complete conversion: temperature register, Data Ready and alert flags
+ */
+void TMP117Sim::convert(void) {
+  static const uint8_t averages[] = { 1, 8, 32, 64 };
+  double t = temperature_(now_ / 1e6) + (int16_t)reg_[t_offset_r] / 128.0;
+  if (noise_ > 0)
+    t += gaussian() * noise_ / sqrt(averages[(reg_[conf_r] & CONF_AVG) >> 5]);
+  long raw = lround(t * 128);
+  int16_t r = raw > INT16_MAX ? INT16_MAX : raw < INT16_MIN ? INT16_MIN : raw;
+
+  reg_[temp_r] = r;
+  reg_[conf_r] |= CONF_DATA_READY;
+  if (!(reg_[conf_r] & CONF_THERM)) {
+    if (r > (int16_t)reg_[thl_r])
+      reg_[conf_r] |= CONF_HIGH_ALERT;
+    if (r < (int16_t)reg_[tll_r])
+      reg_[conf_r] |= CONF_LOW_ALERT;
+  }
+  conversions_++;
+
+  if ((reg_[conf_r] & CONF_MOD) == MOD_ONE_SHOT) {
+    reg_[conf_r] = (reg_[conf_r] & ~CONF_MOD) | MOD_SHUTDOWN;
+    converting_ = false;
+  }
+  else
+    done_ += cycleTime();
+  updatePin();
+}
+
+/**
+ * @brief Alert pin: Data Ready flag (DR/Alert set) or alert flags, falling edge raises the interrupt
+ */
+void TMP117Sim::updatePin(void) {
+  uint16_t c = reg_[conf_r];
+  bool asserted = c & CONF_DRDY ? (c & CONF_DATA_READY) != 0 : (c & (CONF_HIGH_ALERT | CONF_LOW_ALERT)) != 0;
+  if (asserted && !pin_) {
+    alerts_++;
+    pending_[alertPin_] = true;
+  }
+  pin_ = asserted;
+}
+
+uint16_t TMP117Sim::readReg(uint8_t reg) {
+  bool busy = now_ < busyUntil_;
+  uint16_t v = reg_[reg];
+
+  switch (reg) {
+    case temp_r:
+      reg_[conf_r] &= ~CONF_DATA_READY;
+      updatePin();
+      break;
+    case conf_r:
+      if (busy)
+        v |= CONF_EEPROM_BUSY;
+      reg_[conf_r] &= ~(CONF_HIGH_ALERT | CONF_LOW_ALERT | CONF_DATA_READY);
+      updatePin();
+      break;
+    case eep_ul_r:
+      v = (unlocked_ ? 0x8000 : 0) | (busy ? 0x4000 : 0);
+      break;
+  }
+  return v;
+}
+
+void TMP117Sim::writeReg(uint8_t reg, uint16_t value) {
+  switch (reg) {
+    case temp_r:
+    case id_r:
+      return;
+    case eep_ul_r:
+      unlocked_ = value & 0x8000;
+      return;
+    case conf_r:
+      if (value & CONF_SOFT_RESET) {
+        reset();
+        return;
+      }
+      value &= ~(CONF_FLAGS | CONF_SOFT_RESET);
+      reg_[conf_r] = (reg_[conf_r] & CONF_FLAGS) | value;
+      startConversions();
+      updatePin();
+      break;
+    default:
+      reg_[reg] = value;
+  }
+  if (unlocked_) {
+    eeprom_[reg] = value;
+    busyUntil_ = now_ + EEPROM_PROG_TIME;
+  }
+}
+
+uint32_t TMP117Sim::conversionTime(void) const {
+  static const uint32_t convTime[] = { 15500, 125000, 500000, 1000000 };
+  return convTime[(reg_[conf_r] & CONF_AVG) >> 5];
+}
+
+uint32_t TMP117Sim::cycleTime(void) const {
+  static const uint32_t cycle[] = { 15500, 125000, 250000, 500000, 1000000, 4000000, 8000000, 16000000 };
+  uint32_t c = cycle[(reg_[conf_r] & CONF_CONV) >> 7];
+  return c > conversionTime() ? c : conversionTime();
+}
+
+double TMP117Sim::gaussian(void) {
+  double u[2];
+  for (uint8_t i = 0; i < 2; i++) {
+    random_ ^= random_ >> 12;
+    random_ ^= random_ << 25;
+    random_ ^= random_ >> 27;
+    u[i] = ((random_ * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+  }
+  return sqrt(-2 * log(u[0] + 1e-300)) * cos(2 * M_PI * u[1]);
+}
+
+uint32_t TMP117SimClock::now(void) {
+  return TMP117Sim::time() / 1000;
+}
+
+/**
+ * @brief Sleep until wake-up time or Alert interrupt, counting idle time
+ *
+ * @param wakeup Wake-up time [ms]
+ */
+void TMP117SimClock::sleepUntil(uint32_t wakeup) {
+  uint64_t start = TMP117Sim::time();
+  uint32_t delta = wakeup - (uint32_t)(start / 1000);
+  if ((int32_t)delta <= 0)
+    return;
+
+  TMP117Sim::sleep((start / 1000 + delta) * 1000);
+  idle_ += TMP117Sim::time() - start;
+}
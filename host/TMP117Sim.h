@@ -0,0 +1,97 @@
+/**
+ * @file TMP117Sim.h
+ *
+ * @brief Simulated TMP117 devices on a simulated I2C bus, for running the driver on a host
+ *
+ * Models the register map, One-Shot and continuous conversions (conversion and cycle times per datasheet), the
+ * Data Ready and alert (THigh/TLow) flags with the Alert pin, soft reset, EEPROM programming and the general-call
+ * reset. The temperature at the sensor is a caller-supplied function of time, with optional Gaussian noise
+ * (reduced by the averaging mode). Each I2C transaction takes the time it takes at 100kHz.
+ */
+#ifndef _TMP117_SIM_H_
+#define _TMP117_SIM_H_
+
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117EventLoop.h"
+
+#if !defined TMP117_SIM_DEVICES
+#define TMP117_SIM_DEVICES      4
+#endif
+
+class TMP117Sim {
+
+  public:
+    /**
+     * @param address Device I2C address
+     * @param alertPin Pin the Alert output is wired to
+     * @param temperature Temperature at the sensor [°C] as a function of time [s]
+     * @param noise Conversion noise without averaging, rms [°C]
+     */
+              TMP117Sim(uint8_t address, uint8_t alertPin, double (*temperature)(double), double noise = 0.0);
+
+    uint32_t  conversions(void) const { return conversions_; }  // conversions completed
+    uint32_t  alerts(void) const { return alerts_; }            // Alert pin assertions
+    bool      alertAsserted(void) const { return pin_; }
+    void      setTemperature(double (*temperature)(double)) { temperature_ = temperature; }
+    void      setLate(uint32_t us) { late_ = us; }                 // extra conversion time, e.g. a slow device
+
+    static uint64_t time(void) { return now_; }                 // simulated time [µs]
+    static void advance(uint64_t us);                           // run for us µs
+    static bool sleep(uint64_t until);                          // run until time [µs] or an interrupt, true: interrupted
+    static uint32_t transactions(void) { return transactions_; } // I2C transactions
+
+    // bus interface (Wire)
+    static bool write(uint8_t address, const uint8_t *data, uint8_t length);
+    static bool read(uint8_t address, uint8_t *data, uint8_t length);
+    static void attach(uint8_t pin, void (*isr)(void));
+    static void tick(void) { run(now_ + 1, false); }             // CPU time of a millis()/micros() call
+
+  private:
+    const uint8_t address_;
+    const uint8_t alertPin_;
+    double    (*temperature_)(double);
+    const double noise_;
+    uint32_t  late_;
+    uint16_t  reg_[16];
+    uint16_t  eeprom_[16];
+    uint8_t   pointer_;
+    bool      unlocked_;
+    uint64_t  busyUntil_;
+    bool      converting_;
+    uint64_t  done_;                      // end of the conversion in progress [µs]
+    bool      pin_;                       // Alert asserted
+    uint32_t  conversions_;
+    uint32_t  alerts_;
+    uint64_t  random_;
+
+    static TMP117Sim * devices_[TMP117_SIM_DEVICES];
+    static uint8_t deviceCount_;
+    static uint64_t now_;
+    static uint32_t transactions_;
+    static void (*isr_[64])(void);
+    static bool inIsr_;
+    static bool pending_[64];
+
+    static bool run(uint64_t until, bool stopOnInterrupt);
+    static bool deliver(void);
+    static TMP117Sim * find(uint8_t address);
+    void      reset(void);
+    void      startConversions(void);
+    void      convert(void);
+    void      updatePin(void);
+    uint16_t  readReg(uint8_t reg);
+    void      writeReg(uint8_t reg, uint16_t value);
+    uint32_t  conversionTime(void) const;
+    uint32_t  cycleTime(void) const;
+    double    gaussian(void);
+};
+
+// Clock for TMP117EventLoop on the simulated bus: sleeping advances simulated time, Alert interrupts wake up early
+class TMP117SimClock : public TMP117Clock {
+
+  public:
+    uint32_t  now(void);
+    void      sleepUntil(uint32_t wakeup);
+};
+#endif
@@ -0,0 +1,35 @@
+/**
+ * @file Wire.h
+ *
+ * @brief Minimal Arduino Wire API for host builds, transactions are handled by the simulated TMP117 devices
+ */
+#ifndef _HOST_WIRE_H_
+#define _HOST_WIRE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+class TwoWire {
+
+  public:
+              TwoWire() : address_(0), txLength_(0), rxLength_(0), rxPos_(0) {}
+
+    void      begin(void) {}
+    void      beginTransmission(uint8_t address);
+    size_t    write(uint8_t data);
+    uint8_t   endTransmission(bool stop = true);
+    uint8_t   requestFrom(uint8_t address, uint8_t quantity);
+    int       available(void) { return rxLength_ - rxPos_; }
+    int       read(void) { return rxPos_ < rxLength_ ? rx_[rxPos_++] : -1; }
+
+  private:
+    uint8_t   address_;
+    uint8_t   tx_[8];
+    uint8_t   txLength_;
+    uint8_t   rx_[8];
+    uint8_t   rxLength_;
+    uint8_t   rxPos_;
+};
+
+extern TwoWire Wire;
+#endif
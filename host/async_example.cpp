@@ -0,0 +1,50 @@
+/*!
+ * @brief   Host example: coroutine sensor flows (TMP117Async.h) on two simulated TMP117s
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Two flows run interleaved on one thread; each starts a One-Shot conversion, suspends until its sensor's Data
+ * Ready interrupt and prints the sample. The executor sleeps (simulated time) whenever all flows wait.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Async.h"
+#include "TMP117Format.h"
+#include "TMP117Sim.h"
+
+static double room(double s) { return 21.5 + 0.001 * s; }
+static double oven(double s) { return 180.0 - 2.0 * s; }
+
+TMP117Sim device0(ADD0_TO_GND, PIN_A10, room, 0.01);
+TMP117Sim device1(ADD0_TO_VCC, PIN_A11, oven, 0.01);
+TMP117 sensor0(ADD0_TO_GND, PIN_A10);
+TMP117 sensor1(ADD0_TO_VCC, PIN_A11);
+
+static uint8_t samples;
+
+TMP117Task flow(TMP117 &sensor, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    TMP117_sample s = co_await sensor.measure();
+    char text[12];
+    tmp117Format(text, sizeof(text), s.temp, 2);
+    printf("%8.3fs  S%u  %s°C\n", s.timestamp / 1e6, s.sensor, text);
+    samples++;
+  }
+}
+
+int main() {
+  sensor0.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  sensor1.initSetup(TMP117::shutdown, TMP117::no_avg, false, 1);
+
+  TMP117Executor executor;
+  executor.spawn(flow(sensor0, 3));
+  executor.spawn(flow(sensor1, 5));
+  while (executor.run())
+    if (executor.idle())
+      TMP117Sim::sleep(TMP117Sim::time() + 1000000); // until the next Data Ready interrupt
+
+  printf("%u samples, %u conversions, %.3fs\n", samples, device0.conversions() + device1.conversions(), TMP117Sim::time() / 1e6);
+  return samples == 8 ? 0 : 1;
+}
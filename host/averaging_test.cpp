@@ -0,0 +1,63 @@
+/*!
+ * @brief   Host test: automatic averaging against a noise budget (setNoiseBudget())
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Sensor noise 4 counts rms without averaging, budget 2 counts: 8 averages (1.4 counts) is the cheapest mode
+ * meeting the budget. The selection must settle there and stay, whatever mode it starts from.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double constant(double) { return 22.0; }
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, constant, 4 / 128.0);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+
+/**
+ * @returns Averaging mode index (0: none, 1: 8, 2: 32, 3: 64) from the conversion time
+ */
+static uint8_t mode(void) {
+  uint16_t t = sensor.conversionTime();
+  return t <= 16 ? 0 : t <= 125 ? 1 : t <= 500 ? 2 : 3;
+}
+
+static void run(TMP117::TMP117_avg start) {
+  static const char * const names[] = { "1", "8", "32", "64" };
+  uint16_t counts[4] = { 0 };
+  uint8_t switches = 0, last = 0;
+
+  sensor.setAveraging(start);
+  sensor.setNoiseBudget(2);
+  printf("start avg %-2s: ", names[start >> 5]);
+  for (uint16_t i = 0; i < 300; i++) {
+    sensor.startConversion();
+    while (!sensor.pending())
+      TMP117Sim::sleep(TMP117Sim::time() + 1000000);
+    uint32_t serviced = 0;
+    sensor.service(&serviced);
+    uint8_t m = mode();
+    if (i < 40)
+      printf("%s%s", names[m], i < 39 ? "," : "...\n");
+    else {
+      counts[m]++;
+      switches += m != last;
+    }
+    last = m;
+  }
+  printf("  after 40 samples: %u x1, %u x8, %u x32, %u x64, %u switches\n", counts[0], counts[1], counts[2], counts[3], switches);
+  check(counts[1] >= 250 && !counts[0] && switches <= 10, "selection did not settle on 8 averages");
+}
+
+int main() {
+  sensor.initSetup(TMP117::shutdown, TMP117::no_avg, false, 0);
+  run(TMP117::no_avg);
+  run(TMP117::avg64);
+
+  return checkResult();
+}
@@ -0,0 +1,56 @@
+/*!
+ * @brief   Host test: completion barrier with a sensor whose Data Ready arrives after its deadline
+ *
+ * @license MIT License (see license.txt)
+ *
+ * The late event of a missed sweep must not complete the next sweep with the previous conversion's value.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Barrier.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double ramp(double s) { return 10.0 + s; } // 1°C/s: each conversion has its own value
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, ramp);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+TMP117Barrier<1> sweep(5);
+
+/**
+ * @brief Run one sweep, polling every ms until complete
+ *
+ * @returns Time from start to completion [ms]
+ */
+static uint32_t runSweep(void) {
+  uint32_t start = millis();
+  sweep.start(start);
+  while (!sweep.poll(millis()))
+    TMP117Sim::sleep(TMP117Sim::time() + 1000);
+  return millis() - start;
+}
+
+int main() {
+  sensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  sweep.add(sensor);
+
+  device.setLate(20000); // Data Ready 20ms after the 130ms deadline
+  runSweep();
+  check(sweep.missed(0), "slow sensor reported missed");
+  TMP117Sim::advance(100000); // late Data Ready arrives between sweeps
+
+  device.setLate(0);
+  for (uint8_t i = 0; i < 3; i++) {
+    uint32_t start = micros();
+    uint32_t duration = runSweep();
+    printf("sweep %u: %lums, serviced %d, sample at %+ldµs from start\n", i + 2, (unsigned long)duration,
+           sweep.serviced(0), (long)(sensor.sample().timestamp - start));
+    check(sweep.serviced(0), "sensor serviced");
+    check(duration >= sensor.conversionTime(), "sweep waits for the conversion");
+    check((int32_t)(sensor.sample().timestamp - start) > 0, "sample from this sweep");
+  }
+
+  return checkResult();
+}
@@ -0,0 +1,61 @@
+/*!
+ * @brief   Host test: burst capture at the fastest cycle time
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. 64 samples of a 10°C/s ramp: count, average period and jitter against the simulated 15.5ms cycle, each sample
+ *    one cycle's temperature step above the previous one; the device is back in shutdown afterwards.
+ * 2. The sensor's own Data Ready handling is restored: a One-Shot conversion is read by service().
+ * 3. A device whose first conversion never arrives in time: the burst times out with no samples.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double ramp(double s) { return 20.0 + 10.0 * s; }
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, ramp);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+static TMP117_temp samples[64];
+
+int main() {
+  sensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+
+  // 1. burst
+  TMP117_burst report;
+  uint64_t start = TMP117Sim::time();
+  uint16_t n = sensor.burst(samples, 64, &report);
+  uint32_t duration = TMP117Sim::time() - start;
+  uint32_t steps = 0;
+  for (uint16_t i = 1; i < n; i++) // 10°C/s * 15.5ms = 0.155°C: 19.84 counts
+    steps += samples[i].raw() - samples[i - 1].raw() >= 19 && samples[i].raw() - samples[i - 1].raw() <= 21;
+  printf("burst: %u samples in %lums, period %luµs, cycle %lu-%luµs, %u ramp steps of 0.155°C\n", n,
+         (unsigned long)(duration / 1000), (unsigned long)report.period, (unsigned long)report.minCycle,
+         (unsigned long)report.maxCycle, (unsigned)steps);
+  check(n == 64 && report.count == 64, "samples captured");
+  check(report.period == TMP117_CYCLE_MIN, "average period not the 15.5ms cycle");
+  check(report.minCycle == TMP117_CYCLE_MIN && report.maxCycle == TMP117_CYCLE_MIN, "cycle jitter");
+  check(steps == 63, "samples not one cycle apart");
+
+  uint32_t conversions = device.conversions();
+  TMP117Sim::advance(100000);
+  check(device.conversions() == conversions, "device not shut down after the burst");
+
+  // 2. normal operation restored
+  uint32_t serviced = 0;
+  sensor.startConversion();
+  TMP117Sim::advance(200000);
+  check(sensor.service(&serviced) && serviced == 1, "Data Ready handling not restored after the burst");
+
+  // 3. timeout: first conversion 200ms late, the burst of 4 gives up after 4 * 31ms + 50ms
+  device.setLate(200000);
+  start = TMP117Sim::time();
+  n = sensor.burst(samples, 4, &report);
+  duration = TMP117Sim::time() - start;
+  printf("late device: %u samples, gave up after %lums\n", n, (unsigned long)(duration / 1000));
+  check(n == 0 && report.count == 0 && report.period == 0 && duration < 200000, "burst does not time out");
+  return checkResult();
+}
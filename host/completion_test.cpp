@@ -0,0 +1,77 @@
+/*!
+ * @brief   Host test: completion set of serviced sensors
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. 48 sensors (two 32-bit words): set/test/clear per id, pending count, repeated set or clear counted once, ids
+ *    beyond the set ignored, clearAll().
+ * 2. Marked by the read paths: one sensor read by readSensor() from its ISR, one by service() - the set is done only
+ *    after both conversions.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Completion.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double room(double) { return 21.0; }
+
+static TMP117CompletionSet<48> sweep;
+static void readIsr(void);
+
+TMP117Sim device0(ADD0_TO_GND, PIN_A10, room);
+TMP117Sim device1(ADD0_TO_VCC, PIN_A11, room);
+TMP117 isrSensor(ADD0_TO_GND, PIN_A10, readIsr, nullptr);
+TMP117 dispatchedSensor(ADD0_TO_VCC, PIN_A11);
+static TMP117CompletionSet<2> pair;
+
+static void readIsr(void) {
+  isrSensor.readSensor(pair);
+}
+
+int main() {
+  // 1. set operations
+  check(sweep.size() == 48 && sweep.pending() == 48 && !sweep.allDone(), "new set not all pending");
+  for (uint16_t id = 0; id < 48; id++) {
+    sweep.set(id);
+    sweep.set(id); // counted once
+  }
+  sweep.set(48);   // beyond the set
+  sweep.set(100);
+  printf("all set: pending %u, allDone %d\n", sweep.pending(), sweep.allDone());
+  check(sweep.pending() == 0 && sweep.allDone(), "set of all ids not done");
+  check(sweep.test(0) && sweep.test(31) && sweep.test(32) && sweep.test(47) && !sweep.test(48), "test() per id");
+
+  sweep.clear(32);
+  sweep.clear(32);
+  sweep.clear(48);
+  check(sweep.pending() == 1 && !sweep.allDone() && !sweep.test(32) && sweep.test(31) && sweep.test(33),
+        "clear() of one id in the second word");
+
+  sweep.clearAll();
+  uint16_t set = 0;
+  for (uint16_t id = 0; id < 48; id++)
+    set += sweep.test(id);
+  check(sweep.pending() == 48 && set == 0, "clearAll()");
+
+  // 2. marked by readSensor() from the ISR and by service()
+  isrSensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  dispatchedSensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 1);
+  pair.clearAll();
+  uint32_t start = micros();
+  isrSensor.startConversion();
+  dispatchedSensor.startConversion();
+  uint32_t polls = 0;
+  while (!pair.allDone() && polls < 100) {
+    TMP117Sim::sleep(TMP117Sim::time() + 10000);
+    dispatchedSensor.service(pair);
+    polls++;
+  }
+  uint32_t duration = micros() - start;
+  printf("read paths: done after %lums, serviced %d/%d\n", (unsigned long)(duration / 1000), pair.test(0), pair.test(1));
+  check(pair.allDone() && pair.test(0) && pair.test(1), "sensors serviced by both read paths");
+  check(duration >= isrSensor.conversionTime() * 1000ul, "done before the conversions");
+  return checkResult();
+}
@@ -0,0 +1,82 @@
+/*!
+ * @brief   Host test: event loop active vs idle time over a simulated day
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. TMP117VirtualClock: timers with a known amount of simulated work; the idle time must account for exactly
+ *    the rest of the day.
+ * 2. TMP117SimClock on the simulated bus: the example's measurement cycle (One-Shot conversion, Data Ready,
+ *    adaptive interval). The loop must sleep through conversions and between measurements.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117EventLoop.h"
+#include "TMP117Sampler.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+#define DAY     (24 * 3600000ul)
+
+// 1. virtual clock: 10s timer doing 5ms of work, 60s timer doing 20ms
+TMP117VirtualClock virtualClock;
+TMP117EventLoop virtualEvents(virtualClock);
+static uint32_t work;
+
+static void fast(void) { virtualClock.advance(5); work += 5; }
+static void slow(void) { virtualClock.advance(20); work += 20; }
+
+// 2. simulated bus: daily temperature cycle, sensor read on Data Ready, next measurement after the sampler interval
+static double daily(double s) { return 20.0 + 5.0 * sin(2 * M_PI * s / 86400); }
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, daily, 0.01);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+TMP117SimClock simClock;
+TMP117EventLoop events(simClock);
+TMP117Sampler sampler(10 * 1000, 15 * 60 * 1000, 13);
+static uint32_t measurements;
+
+static void measure(void) {
+  sensor.startConversion();
+}
+
+static void sensorReady(TMP117 &s) {
+  measurements++;
+  events.after(sampler.update(s.getTemperature(T_NOW).raw(), millis()), measure);
+}
+
+int main() {
+  uint32_t runs = 0;
+
+  virtualEvents.every(10000, fast);
+  virtualEvents.every(60000, slow);
+  while (virtualEvents.elapsed() < DAY) {
+    virtualEvents.run();
+    runs++;
+  }
+  uint32_t active = virtualEvents.elapsed() - virtualEvents.idleTime();
+  printf("virtual clock: %lu run() calls, active %lums (work %lums), idle %lums of %lums\n", (unsigned long)runs,
+         (unsigned long)active, (unsigned long)work, (unsigned long)virtualEvents.idleTime(),
+         (unsigned long)virtualEvents.elapsed());
+  check(active == work, "idle time accounts for all time not spent in timers");
+  check(runs <= 8640 + 1440 + 2, "one wake-up per timer expiry");
+
+  runs = 0;
+  sensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  events.watch(sensor, sensorReady);
+  measure();
+  while (events.elapsed() < DAY) {
+    events.run();
+    runs++;
+  }
+  active = events.elapsed() - events.idleTime();
+  printf("simulated bus: %lu measurements, %lu run() calls, %lu I2C transactions, active %lums (%.4f%%)\n",
+         (unsigned long)measurements, (unsigned long)runs, (unsigned long)TMP117Sim::transactions(),
+         (unsigned long)active, active * 100.0 / events.elapsed());
+  check(runs <= 2 * measurements + 2, "wakes up only for timers and Data Ready");
+  check(active * 1000 < events.elapsed(), "active less than 0.1% of the day");
+
+  return checkResult();
+}
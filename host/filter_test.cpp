@@ -0,0 +1,114 @@
+/*!
+ * @brief   Host test: sample stream filters (EMA, boxcar, median, decimation) and the flags of filtered samples
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Samples are fed to the filter sinks directly, no sensor needed:
+ * - step responses of the EMA and the boxcar, rounding of negative averages
+ * - a single spike passes neither the median of 3 nor its TMP117_NEW_MAX flag
+ * - decimation passes every Nth sample with its timestamp
+ * - TMP117_NEW_MIN/NEW_MAX are recomputed for the filtered stream, other flags are passed on
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Filter.h"
+#include "TMP117Check.h"
+
+// Sink recording the filtered samples
+class Collector : public TMP117Sink {
+
+  public:
+              Collector() : count(0) {}
+
+    void onSample(const TMP117_sample &sample) {
+      if (count < sizeof(samples) / sizeof(samples[0]))
+        samples[count] = sample;
+      count++;
+    }
+
+    TMP117_sample samples[64];
+    uint16_t  count;
+};
+
+static void feed(TMP117Sink &sink, const int16_t *raw, uint8_t n, const uint8_t *flags = nullptr) {
+  for (uint8_t i = 0; i < n; i++) {
+    TMP117_sample s = { 0, (uint8_t)(flags != nullptr ? flags[i] : 0), TMP117_temp(raw[i]), (uint32_t)i * 1000 };
+    sink.onSample(s);
+  }
+}
+
+int main() {
+  // EMA 1/4: 0, then a step to 1000
+  TMP117FilterSink<TMP117Ema<2>> ema;
+  Collector emaOut;
+  ema.attach(emaOut);
+  int16_t step[40] = { 0 };
+  for (uint8_t i = 1; i < 40; i++)
+    step[i] = 1000;
+  feed(ema, step, 40);
+  printf("EMA<2>:      %d %d %d %d ... %d\n", emaOut.samples[0].temp.raw(), emaOut.samples[1].temp.raw(),
+         emaOut.samples[2].temp.raw(), emaOut.samples[3].temp.raw(), emaOut.samples[39].temp.raw());
+  check(emaOut.count == 40 && emaOut.samples[0].temp.raw() == 0 && emaOut.samples[1].temp.raw() == 250 &&
+        emaOut.samples[2].temp.raw() == 438 && emaOut.samples[39].temp.raw() == 1000, "EMA step response");
+
+  // boxcar of 4: step after 4 zeros, then averages of negative values round half away from zero
+  TMP117FilterSink<TMP117Boxcar<4>> boxcar;
+  Collector boxOut;
+  boxcar.attach(boxOut);
+  static const int16_t box[] = { 0, 0, 0, 0, 1000, 1000, 1000, 1000, -1, -1, -1, -1, -2, -2 };
+  feed(boxcar, box, sizeof(box) / sizeof(box[0]));
+  printf("Boxcar<4>:   %d %d %d %d, %d %d\n", boxOut.samples[4].temp.raw(), boxOut.samples[5].temp.raw(),
+         boxOut.samples[6].temp.raw(), boxOut.samples[7].temp.raw(), boxOut.samples[12].temp.raw(),
+         boxOut.samples[13].temp.raw());
+  check(boxOut.count == 14 && boxOut.samples[4].temp.raw() == 250 && boxOut.samples[5].temp.raw() == 500 &&
+        boxOut.samples[6].temp.raw() == 750 && boxOut.samples[7].temp.raw() == 1000, "boxcar step response");
+  check(boxOut.samples[11].temp.raw() == -1 && boxOut.samples[12].temp.raw() == -1 &&
+        boxOut.samples[13].temp.raw() == -2, "boxcar rounding of negative averages"); // -5/4, -6/4 (half: away)
+
+  // median of 3: a one-sample spike flagged as a new maximum by the sensor
+  TMP117FilterSink<TMP117Median<3>> median;
+  Collector medianOut;
+  median.attach(medianOut);
+  static const int16_t spiky[] = { 100, 100, 100, 3000, 100, 100, 120, 120, 120 };
+  static const uint8_t spikyFlags[] = { TMP117_NEW_MIN | TMP117_NEW_MAX, 0, 0, TMP117_NEW_MAX | TMP117_EEPROM_ERR, 0,
+                                        0, TMP117_NEW_MAX, 0, 0 };
+  feed(median, spiky, sizeof(spiky) / sizeof(spiky[0]), spikyFlags);
+  uint16_t highest = 0, newMax = 0;
+  for (uint16_t i = 0; i < medianOut.count; i++) {
+    if (medianOut.samples[i].temp.raw() > highest)
+      highest = medianOut.samples[i].temp.raw();
+    newMax += (medianOut.samples[i].flags & TMP117_NEW_MAX) != 0;
+  }
+  printf("Median<3>:   highest %u, %u new maxima, spike flags 0x%02x\n", highest, newMax, medianOut.samples[3].flags);
+  check(medianOut.count == 9 && highest == 120, "median passes the spike");
+  check(medianOut.samples[3].flags == TMP117_EEPROM_ERR, "spike flagged as a new maximum of the filtered stream");
+  check(newMax == 2 && (medianOut.samples[0].flags & TMP117_NEW_MIN) && (medianOut.samples[7].flags & TMP117_NEW_MAX),
+        "new maxima of the filtered stream not flagged");
+
+  // decimation by 4, falling temperature: every output is a new minimum
+  TMP117FilterSink<TMP117Decimate<4>> decimate;
+  Collector decimateOut;
+  decimate.attach(decimateOut);
+  int16_t falling[12];
+  for (uint8_t i = 0; i < 12; i++)
+    falling[i] = 1000 - i;
+  feed(decimate, falling, 12);
+  printf("Decimate<4>: %u samples, last %d at %luµs\n", decimateOut.count, decimateOut.samples[2].temp.raw(),
+         (unsigned long)decimateOut.samples[2].timestamp);
+  check(decimateOut.count == 3 && decimateOut.samples[0].temp.raw() == 997 && decimateOut.samples[2].temp.raw() == 989 &&
+        decimateOut.samples[2].timestamp == 11000, "decimation passes every 4th sample");
+  check(decimateOut.samples[1].flags == TMP117_NEW_MIN && decimateOut.samples[2].flags == TMP117_NEW_MIN,
+        "falling filtered stream not flagged as new minimum");
+
+  // chain: median -> EMA -> decimation
+  TMP117FilterSink<TMP117Chain<TMP117Median<3>, TMP117Ema<3>, TMP117Decimate<8>>> chain;
+  Collector chainOut;
+  chain.attach(chainOut);
+  for (uint8_t r = 0; r < 4; r++)
+    feed(chain, spiky, sizeof(spiky) / sizeof(spiky[0]));
+  printf("Chain:       %u samples of 36, last %d\n", chainOut.count, chainOut.samples[3].temp.raw());
+  check(chainOut.count == 4 && chainOut.samples[3].temp.raw() <= 120, "chained filters");
+  return checkResult();
+}
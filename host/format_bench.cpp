@@ -0,0 +1,148 @@
+/*!
+ * @brief   Host benchmark: tmp117Format() vs the former print(temperature * TMP117_RES, 2) path
+ *
+ * @license MIT License (see license.txt)
+ *
+ * The reference is the Arduino float printer (Print::printFloat() of the SAMD core, rendering into a buffer
+ * instead of the serial port), fed with the raw value scaled in double as the example used to do. Both render
+ * all 65536 raw values with 2 and 7 decimals.
+ *
+ * Reported:
+ * - results differing from the exactly rounded decimal (half away from zero)
+ * - host time per call
+ * - double operations per call: on the Cortex-M0+ (no FPU) each one is a call into the soft-float library, and the
+ *   float printer pulls these routines into flash. tmp117Format() needs 32-bit integer multiply/divide only.
+ *   Target flash and cycles cannot be measured in a host build; the operation counts are what scales.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Format.h"
+#include "TMP117Check.h"
+
+// double wrapper counting arithmetic and comparisons (conversions: toDouble())
+class counted {
+
+  public:
+    static uint32_t ops;
+
+              counted(double v = 0) : v_(v) {}
+              operator unsigned long() const { ops++; return v_; }
+    counted   operator*(counted b) const { ops++; return counted(v_ * b.v_); }
+    counted   operator/(counted b) const { ops++; return counted(v_ / b.v_); }
+    counted   operator+(counted b) const { ops++; return counted(v_ + b.v_); }
+    counted   operator-(counted b) const { ops++; return counted(v_ - b.v_); }
+    counted & operator*=(counted b) { ops++; v_ *= b.v_; return *this; }
+    counted & operator/=(counted b) { ops++; v_ /= b.v_; return *this; }
+    counted & operator+=(counted b) { ops++; v_ += b.v_; return *this; }
+    counted & operator-=(counted b) { ops++; v_ -= b.v_; return *this; }
+    bool      operator<(counted b) const { ops++; return v_ < b.v_; }
+    bool      operator>(counted b) const { ops++; return v_ > b.v_; }
+
+  private:
+    double    v_;
+};
+uint32_t counted::ops;
+
+static double toDouble(long v, double) { return v; }
+static counted toDouble(long v, counted) { counted::ops++; return counted(v); }
+
+/**
+ * @brief Print::printFloat() of the Arduino SAMD core, into a buffer
+ */
+template <typename D>
+static size_t printFloat(char *buffer, D number, uint8_t digits) {
+  char *p = buffer;
+  if (number < D(0.0)) {
+    *p++ = '-';
+    number = D(0.0) - number;
+  }
+
+  // round correctly so that print(1.999, 2) prints as "2.00"
+  D rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i)
+    rounding /= D(10.0);
+  number += rounding;
+
+  unsigned long intPart = (unsigned long)number;
+  D remainder = number - toDouble(intPart, number);
+  p += sprintf(p, "%lu", intPart);
+  if (digits > 0)
+    *p++ = '.';
+  while (digits-- > 0) {
+    remainder *= D(10.0);
+    unsigned int toPrint = (unsigned int)(unsigned long)remainder;
+    *p++ = '0' + toPrint;
+    remainder -= toDouble(toPrint, number);
+  }
+  *p = '\0';
+  return p - buffer;
+}
+
+/**
+ * @brief Exactly rounded reference: raw / 128 = raw * 78125 / 10^7 exactly
+ */
+static void exact(char *buffer, size_t size, int16_t raw, uint8_t decimals) {
+  static const long long pow10[] = { 10000000, 1000000, 100000, 10000, 1000, 100, 10, 1 };
+  long long mag = raw < 0 ? -(long long)raw * 78125 : (long long)raw * 78125;
+  long long div = pow10[decimals];
+  long long v = (mag + div / 2) / div;
+  long long scale = 10000000 / div;
+  const char *sign = raw < 0 && v ? "-" : "";
+  if (decimals)
+    snprintf(buffer, size, "%s%d.%0*d", sign, (int)(v / scale), (int)decimals & 7, (int)(v % scale));
+  else
+    snprintf(buffer, size, "%s%d", sign, (int)v);
+}
+
+int main() {
+  static const uint8_t decimals[] = { 2, 7 };
+
+  for (uint8_t d = 0; d < 2; d++) {
+    uint32_t wrongFloat = 0, wrongFormat = 0;
+    char ref[16], text[16];
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++) {
+      exact(ref, sizeof(ref), raw, decimals[d]);
+      printFloat(text, raw * 0.0078125, decimals[d]);
+      wrongFloat += strcmp(text, ref) != 0;
+      tmp117Format(text, sizeof(text), TMP117_temp(raw), decimals[d]);
+      wrongFormat += strcmp(text, ref) != 0;
+    }
+
+    counted::ops = 0;
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++)
+      printFloat(text, toDouble(raw, counted()) * counted(0.0078125), decimals[d]);
+    double ops = counted::ops / 65536.0;
+
+    volatile size_t sink = 0;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (uint8_t r = 0; r < 10; r++)
+      for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++)
+        sink += printFloat(text, raw * 0.0078125, decimals[d]);
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    for (uint8_t r = 0; r < 10; r++)
+      for (int32_t raw = INT16_MIN; raw <= INT16_MAX; raw++)
+        sink += tmp117Format(text, sizeof(text), TMP117_temp(raw), decimals[d]);
+    std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+    double nsFloat = std::chrono::duration<double, std::nano>(t1 - t0).count() / (10 * 65536.0);
+    double nsFormat = std::chrono::duration<double, std::nano>(t2 - t1).count() / (10 * 65536.0);
+
+    printf("%u decimals: float printer %5u wrong, %5.1fns, %4.1f double ops per call\n", decimals[d],
+           (unsigned)wrongFloat, nsFloat, ops);
+    printf("            tmp117Format  %5u wrong, %5.1fns, 0 double ops\n", (unsigned)wrongFormat, nsFormat);
+    check(wrongFormat == 0, "tmp117Format() not exactly rounded");
+  }
+
+  // too small buffer: 0 and an empty string; the longest result fits 13 bytes
+  char small[13];
+  memset(small, 'x', sizeof(small));
+  size_t len = tmp117Format(small, 6, TMP117_temp::fromDegrees(-12), 2);
+  check(len == 0 && small[0] == '\0', "buffer too small not reported as empty string");
+  len = tmp117Format(small, sizeof(small), TMP117_temp(INT16_MIN), 7);
+  printf("longest: \"%s\", %u bytes with NUL\n", small, (unsigned)len + 1);
+  check(len + 1 == sizeof(small), "longest result not 13 bytes");
+  return checkResult();
+}
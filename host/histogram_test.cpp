@@ -0,0 +1,70 @@
+/*!
+ * @brief   Host test: temperature histogram counters and export at the template limits
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. N = 255 (N + 2 bins do not fit an 8-bit index): clear() and serialize() must terminate and cover all bins.
+ * 2. A month at one sample per second in one bin: the count must not saturate at 16 bits and must survive the
+ *    varint export.
+ * 3. Bin widths that are not a power of two (13 counts, ≈0.1°C), bin edges beyond the temperature range.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117TempHistogram.h"
+#include "TMP117Check.h"
+
+TMP117TempHistogram<255> wide(TMP117_temp::fromDegrees(0), TMP117_temp(1));
+TMP117TempHistogram<4> survey(TMP117_temp::fromDegrees(-5), TMP117_temp::fromMilli(500));
+TMP117TempHistogram<50> fine(TMP117_temp::fromDegrees(20), TMP117_temp::fromMilli(100));
+TMP117TempHistogram<255> hot(TMP117_temp::fromDegrees(200), TMP117_temp::fromMilli(500));
+static uint8_t data[5 + 5 * (255 + 2)];
+
+int main() {
+  // 1. one sample in every bin, underflow and overflow
+  for (int16_t raw = -1; raw <= 255; raw++)
+    wide.add(raw);
+  size_t len = wide.serialize(data, sizeof(data));
+  printf("N = 255: %u bytes exported\n", (unsigned)len);
+  check(len == 5 + 255 + 2, "one varint byte per bin");
+  check(wide.underflow() == 1 && wide.count(0) == 1 && wide.count(254) == 1 && wide.overflow() == 1, "all bins counted");
+  wide.clear();
+  check(wide.count(254) == 0 && wide.overflow() == 0, "all bins cleared");
+
+  // 2. 31 days at 1 sample/s at -5°C (bin 0: -5°C to -4.5°C)
+  const uint32_t month = 31ul * 24 * 3600;
+  for (uint32_t i = 0; i < month; i++)
+    survey.add(TMP117_temp::fromDegrees(-5).raw());
+  len = survey.serialize(data, sizeof(data));
+  uint32_t decoded = 0;
+  for (size_t i = 0, shift = 0; 6 + i < len; i++, shift += 7) { // bin 0 follows header and underflow
+    decoded |= (uint32_t)(data[6 + i] & 0x7F) << shift;
+    if (!(data[6 + i] & 0x80))
+      break;
+  }
+  printf("month: count %lu, exported %lu in %u bytes\n", (unsigned long)survey.count(0), (unsigned long)decoded,
+         (unsigned)len);
+  check(survey.count(0) == month, "count beyond 16 bits");
+  check(decoded == month, "varint export of a 32-bit count");
+
+  // 3. 13-count bins from 20°C: 20.000-20.094°C in bin 0, 20.102°C in bin 1, 25.070°C in the last bin, 25.078°C above
+  fine.add(TMP117_temp::fromMilli(20094).raw());
+  fine.add(TMP117_temp::fromMilli(20102).raw());
+  fine.add(TMP117_temp::fromMilli(25070).raw());
+  fine.add(TMP117_temp::fromMilli(25078).raw());
+  printf("13-count bins: edges %ld, %ld, ... %ldm°C\n", (long)fine.lowerEdge(1).milli(), (long)fine.lowerEdge(2).milli(),
+         (long)fine.lowerEdge(50).milli());
+  check(fine.count(0) == 1 && fine.count(1) == 1 && fine.count(49) == 1 && fine.overflow() == 1, "13-count bins");
+  check(fine.lowerEdge(1).raw() == 20 * 128 + 13 && fine.lowerEdge(50).raw() == 20 * 128 + 650, "13-count bin edges");
+
+  // edges from 200°C in 0.5°C bins pass +255.99°C at bin 112
+  hot.add(INT16_MAX);
+  printf("0.5°C bins from 200°C: edge of bin 111 %ldm°C, bin 112 %ldm°C, bin 255 %ldm°C\n",
+         (long)hot.lowerEdge(111).milli(), (long)hot.lowerEdge(112).milli(), (long)hot.lowerEdge(255).milli());
+  check(hot.lowerEdge(111) == TMP117_temp::fromMilli(255500) && hot.lowerEdge(112).raw() == INT16_MAX &&
+        hot.lowerEdge(255).raw() == INT16_MAX, "bin edges beyond the temperature range not limited");
+  check(hot.count(111) == 1 && hot.quantile(500) == TMP117_temp::fromMilli(255750), "highest temperature binned");
+
+  return checkResult();
+}
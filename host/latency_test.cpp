@@ -0,0 +1,62 @@
+/*!
+ * @brief   Host test: Alert-to-read latency histogram entries by read path
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Two sensors in continuous mode for 10s:
+ * - read by readSensor() from their own ISR: no Alert time is recorded, so no latency entries (read durations only)
+ * - dispatched to dataReady() and read by service() 2ms later: one latency entry per read, in the 2ms bucket
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double room(double) { return 21.0; }
+
+static uint32_t serviced;
+static void readIsr(void);
+
+TMP117Sim direct(ADD0_TO_GND, PIN_A10, room);
+TMP117Sim deferred(ADD0_TO_VCC, PIN_A11, room);
+TMP117 isrSensor(ADD0_TO_GND, PIN_A10, readIsr, nullptr);
+TMP117 dispatchedSensor(ADD0_TO_VCC, PIN_A11);
+
+static void readIsr(void) {
+  isrSensor.readSensor(&serviced);
+}
+
+static uint32_t entries(const TMP117_histogram &h) {
+  uint32_t n = 0;
+  for (uint8_t i = 0; i < TMP117_LATENCY_BUCKETS; i++)
+    n += h.bucket[i];
+  return n;
+}
+
+int main() {
+  isrSensor.initSetup(TMP117::continuous, TMP117::no_avg, false, 0);
+  dispatchedSensor.initSetup(TMP117::continuous, TMP117::no_avg, false, 1);
+
+  uint32_t reads = 0;
+  while (TMP117Sim::time() < 10000000) {
+    TMP117Sim::sleep(TMP117Sim::time() + 1000000);
+    if (dispatchedSensor.pending()) {
+      TMP117Sim::advance(2000);
+      reads += dispatchedSensor.service(&serviced);
+    }
+  }
+
+  printf("readSensor(): %u latency, %u read duration entries, %u conversions\n",
+         (unsigned)entries(isrSensor.latency()), (unsigned)entries(isrSensor.readDuration()), direct.conversions());
+  printf("service():    %u latency entries (%u in [1024, 2048)µs), %u reads\n",
+         (unsigned)entries(dispatchedSensor.latency()), dispatchedSensor.latency().bucket[10], (unsigned)reads);
+
+  check(direct.conversions() >= 10 && entries(isrSensor.readDuration()) >= direct.conversions() - 1,
+        "readSensor() reads not recorded");
+  check(entries(isrSensor.latency()) == 0, "readSensor() recorded a latency without an Alert time");
+  check(reads >= 10 && dispatchedSensor.latency().bucket[10] == reads && entries(dispatchedSensor.latency()) == reads,
+        "service() latency not recorded from the dataReady() time");
+  return checkResult();
+}
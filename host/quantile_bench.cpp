@@ -0,0 +1,169 @@
+/*!
+ * @brief   Host benchmark: streaming quantiles (P² with 5/9/17 markers, histogram) vs exact quantiles
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 30 days per profile, one sample every 10s, estimates reset daily as for a daily P5/P50/P95 report. Profiles:
+ * - daily: 20°C ± 5°C daily cycle with 0.05°C noise
+ * - cold chain: 4°C with 0.02°C noise and 6 door openings a day (+3°C, decaying over 15 minutes) - skewed
+ * - random walk: 0.02°C steps around 20°C
+ *
+ * Reported per marker count: mean and max. absolute error against the exact (sorted, nearest-rank) daily quantile,
+ * host time per sample and memory. Time on the target scales with the same O(N) marker loop (no FPU needed).
+ * More markers lower the mean error over all cases, but not in every case (e.g. the daily P50): the marker count is
+ * not an accuracy setting. One TMP117TempHistogram<96> of 0.125°C bins (one update per sample for all three
+ * quantiles) answers any quantile within half a bin, but only within its range.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Quantile.h"
+#include "TMP117TempHistogram.h"
+#include "TMP117Check.h"
+
+#define DAYS        30
+#define PER_DAY     8640                  // one sample every 10s
+
+static const uint16_t quantiles[] = { 50, 500, 950 };
+
+static uint64_t random_ = 12345;
+
+static double uniform(void) {
+  random_ = random_ * 6364136223846793005ull + 1442695040888963407ull;
+  return ((random_ >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double gaussian(void) {
+  return sqrt(-2 * log(uniform())) * cos(2 * M_PI * uniform());
+}
+
+static double daily(uint32_t i) {
+  return 20.0 + 5.0 * sin(2 * M_PI * i / PER_DAY) + 0.05 * gaussian();
+}
+
+static double coldChain(uint32_t) {
+  static double excursion;
+  excursion *= exp(-10.0 / 900);
+  if (uniform() < 6.0 / PER_DAY)
+    excursion += 3.0;
+  return 4.0 + excursion + 0.02 * gaussian();
+}
+
+static double randomWalk(uint32_t) {
+  static double t = 20.0;
+  t += 0.02 * gaussian() - 0.0001 * (t - 20.0);
+  return t;
+}
+
+typedef struct {
+  double    mean;                         // mean absolute error [°C]
+  double    max;                          // max. absolute error [°C]
+} error_t;
+
+/**
+ * @brief Run all days of one profile through N-marker estimators of all quantiles
+ *
+ * @param ns Host time per sample and estimator [ns] (output)
+ */
+template <uint8_t N>
+static void run(const std::vector<int16_t> &samples, error_t *errors, double &ns) {
+  double time = 0;
+  for (uint8_t j = 0; j < 3; j++)
+    errors[j].mean = errors[j].max = 0;
+
+  for (uint32_t d = 0; d < DAYS; d++) {
+    std::vector<int16_t> day(samples.begin() + d * PER_DAY, samples.begin() + (d + 1) * PER_DAY);
+    std::vector<int16_t> sorted(day);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (uint8_t j = 0; j < 3; j++) {
+      TMP117QuantileP2<N> q(quantiles[j]);
+      std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+      for (uint32_t i = 0; i < PER_DAY; i++)
+        q.add(day[i]);
+      time += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+      int16_t exact = sorted[(PER_DAY * quantiles[j] + 999) / 1000 - 1];
+      double err = fabs(q.value().raw() - exact) / 128.0;
+      errors[j].mean += err / DAYS;
+      if (err > errors[j].max)
+        errors[j].max = err;
+    }
+  }
+  ns = time / (3.0 * DAYS * PER_DAY);
+}
+
+template <uint8_t N>
+static void report(const std::vector<int16_t> &samples, error_t *errors) {
+  double ns;
+  run<N>(samples, errors, ns);
+  printf("  %2u markers (%3u bytes, %5.1fns/sample):", N, (unsigned)sizeof(TMP117QuantileP2<N>), ns);
+  for (uint8_t j = 0; j < 3; j++)
+    printf("  P%-2u %.3f°C (max. %.3f)", quantiles[j] / 10, errors[j].mean, errors[j].max);
+  printf("\n");
+}
+
+// histogram over origin + 12°C in 0.125°C bins
+static void histogram(const std::vector<int16_t> &samples, int16_t origin, error_t *errors) {
+  double time = 0;
+  for (uint8_t j = 0; j < 3; j++)
+    errors[j].mean = errors[j].max = 0;
+
+  for (uint32_t d = 0; d < DAYS; d++) {
+    std::vector<int16_t> day(samples.begin() + d * PER_DAY, samples.begin() + (d + 1) * PER_DAY);
+    TMP117TempHistogram<96> h(TMP117_temp::fromDegrees(origin), TMP117_temp::fromMilli(125));
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < PER_DAY; i++)
+      h.add(day[i]);
+    time += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    std::sort(day.begin(), day.end());
+
+    for (uint8_t j = 0; j < 3; j++) {
+      int16_t exact = day[(PER_DAY * quantiles[j] + 999) / 1000 - 1];
+      double err = fabs(h.quantile(quantiles[j]).raw() - exact) / 128.0;
+      errors[j].mean += err / DAYS;
+      if (err > errors[j].max)
+        errors[j].max = err;
+    }
+  }
+  printf("  histogram  (%3u bytes, %5.1fns/sample):", (unsigned)sizeof(TMP117TempHistogram<96>),
+         time / (DAYS * PER_DAY));
+  for (uint8_t j = 0; j < 3; j++)
+    printf("  P%-2u %.3f°C (max. %.3f)", quantiles[j] / 10, errors[j].mean, errors[j].max);
+  printf("\n");
+}
+
+int main() {
+  static const char * const names[] = { "daily", "cold chain", "random walk" };
+  static double (* const profiles[])(uint32_t) = { daily, coldChain, randomWalk };
+  static const int16_t origins[] = { 14, 3, 14 };
+  double sum5 = 0, sum17 = 0, sumHist = 0;
+  for (uint8_t p = 0; p < 3; p++) {
+    std::vector<int16_t> samples;
+    for (uint32_t i = 0; i < DAYS * PER_DAY; i++)
+      samples.push_back(lround(profiles[p](i) * 128));
+
+    error_t e5[3], e9[3], e17[3], eh[3];
+    printf("%s:\n", names[p]);
+    report<5>(samples, e5);
+    report<9>(samples, e9);
+    report<17>(samples, e17);
+    histogram(samples, origins[p], eh);
+
+    for (uint8_t j = 0; j < 3; j++) {
+      sum5 += e5[j].mean;
+      sum17 += e17[j].mean;
+      sumHist += eh[j].mean;
+      check(eh[j].max <= 0.0625, "%s P%u histogram off by more than half a bin", names[p], quantiles[j] / 10);
+    }
+  }
+  printf("mean error over all profiles and quantiles: %.3f°C with 5 markers, %.3f°C with 17, %.3f°C histogram\n",
+         sum5 / 9, sum17 / 9, sumHist / 9);
+  check(sumHist < sum5 && sumHist < sum17, "histogram not more accurate than P²");
+  return checkResult();
+}
@@ -0,0 +1,77 @@
+/*!
+ * @brief   Host test: sample ring buffer - empty, full, index wrap-around and filling from the read path
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. An empty ring pops nothing; a full ring drops and counts the new sample, keeping the oldest ones.
+ * 2. 70000 samples through a ring of 4, so the 16-bit head/tail indices wrap: no sample lost, reordered or repeated.
+ * 3. Attached to a simulated sensor as a sink, the ring is filled by service() and drained by the consumer.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Ring.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double ramp(double s) { return 10.0 + s; }
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, ramp);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+TMP117Ring<4> small;
+TMP117Ring<8> samples;
+
+static TMP117_sample record(uint32_t i) {
+  TMP117_sample s = { 0, 0, TMP117_temp((int16_t)(i & 0x7FFF)), i };
+  return s;
+}
+
+int main() {
+  // 1. empty and full
+  TMP117_sample s;
+  check(!small.pop(s) && small.size() == 0, "empty ring pops a sample");
+  for (uint32_t i = 0; i < 4; i++)
+    check(!small.push(record(i)), "push %u into a ring of 4 failed", (unsigned)i);
+  bool dropped = small.push(record(4));
+  printf("full: size %u, push dropped %d, overruns %lu\n", small.size(), dropped, (unsigned long)small.overruns());
+  check(dropped && small.size() == 4 && small.overruns() == 1, "full ring does not drop the new sample");
+  for (uint32_t i = 0; i < 4; i++)
+    check(small.pop(s) && s.timestamp == i, "oldest samples not kept");
+  check(!small.pop(s) && small.size() == 0, "drained ring pops a sample");
+
+  // 2. index wrap-around, the ring kept between 1 and 3 samples
+  uint32_t next = 4, expected = 4, errors = 0;
+  small.push(record(next++));
+  while (next < 70000) {
+    small.push(record(next++));
+    small.push(record(next++));
+    for (uint8_t k = 0; k < 2; k++)
+      errors += !small.pop(s) || s.timestamp != expected++;
+  }
+  while (small.pop(s))
+    errors += s.timestamp != expected++;
+  printf("wrap-around: %lu samples, %lu errors, overruns %lu\n", (unsigned long)(expected - 4), (unsigned long)errors,
+         (unsigned long)small.overruns());
+  check(errors == 0 && expected == next && small.overruns() == 1, "samples lost or reordered at the index wrap");
+
+  // 3. filled by the read path: one-shot conversions, drained after every 3 reads
+  sensor.initSetup(TMP117::shutdown, TMP117::no_avg, false, 0);
+  sensor.attach(samples);
+  uint32_t reads = 0, popped = 0, ordered = 1, last = 0, serviced = 0;
+  while (reads < 30) {
+    sensor.startConversion();
+    while (!sensor.service(&serviced))
+      TMP117Sim::sleep(TMP117Sim::time() + 100000);
+    if (++reads % 3 == 0)
+      while (samples.pop(s)) {
+        ordered &= popped == 0 || (int32_t)(s.timestamp - last) > 0;
+        last = s.timestamp;
+        popped++;
+      }
+  }
+  printf("read path: %lu reads, %lu samples popped, overruns %lu\n", (unsigned long)reads, (unsigned long)popped,
+         (unsigned long)samples.overruns());
+  check(popped == reads && ordered && samples.overruns() == 0, "samples of the read path lost");
+  return checkResult();
+}
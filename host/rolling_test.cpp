@@ -0,0 +1,68 @@
+/*!
+ * @brief   Host test: rolling min/max (TMP117Window) against a brute-force scan of the window
+ *
+ * @license MIT License (see license.txt)
+ *
+ * A day-long cooling ramp (the worst case for a sample-based monotonic deque) and a noisy random walk, one sample
+ * per minute, 24-hour window in 24 blocks. The result must cover the whole window and at most one block more.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Window.h"
+#include "TMP117Check.h"
+
+#define SAMPLES 4320                      // 3 days
+#define WINDOW  86400000ul
+#define BLOCK   (WINDOW / 24)
+
+static int16_t data[SAMPLES];
+
+static bool run(const char *name) {
+  TMP117Window<24> lastDay(WINDOW);
+  uint32_t errors = 0;
+  int16_t maxError = 0;
+
+  for (uint32_t i = 0; i < SAMPLES; i++) {
+    uint32_t now = i * 60000;
+    lastDay.add(data[i], now);
+
+    // exact extremes over the window, and over the window + one block
+    int16_t lo = data[i], hi = data[i], loX = data[i], hiX = data[i];
+    for (uint32_t j = 0; j <= i; j++) {
+      uint32_t age = now - j * 60000;
+      if (age < WINDOW) {
+        if (data[j] < lo) lo = data[j];
+        if (data[j] > hi) hi = data[j];
+      }
+      if (age < WINDOW + BLOCK) {
+        if (data[j] < loX) loX = data[j];
+        if (data[j] > hiX) hiX = data[j];
+      }
+    }
+    int16_t mn = lastDay.min().raw(), mx = lastDay.max().raw();
+    if (mn > lo || mn < loX || mx < hi || mx > hiX)
+      errors++;
+    if (mx - hi > maxError) maxError = mx - hi;
+    if (lo - mn > maxError) maxError = lo - mn;
+  }
+  printf("%-12s %u errors, extra range from the partial block: max %.2f°C, %u bytes\n", name, errors,
+         maxError / 128.0, (unsigned)sizeof(TMP117Window<24>));
+  return errors == 0;
+}
+
+int main() {
+  for (uint32_t i = 0; i < SAMPLES; i++)
+    data[i] = 3200 - (int32_t)i * 1184 / 1440; // 25°C, cooling 9.25°C per day
+  check(run("cooling ramp"), "cooling ramp");
+
+  srand(1);
+  int16_t t = 2560;
+  for (uint32_t i = 0; i < SAMPLES; i++)
+    data[i] = t += rand() % 41 - 20;
+  check(run("random walk"), "random walk");
+
+  return checkResult();
+}
@@ -0,0 +1,43 @@
+/*!
+ * @brief   Host test: sample time base over long gaps and beyond the 32-bit µs/ms ranges
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Samples every 2 hours (as in window alert mode, the µs timestamp wraps between samples) for 60 days (the ms
+ * counter wraps after 49.7 days). Day rollups must stay aligned, each with 12 samples.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Rollup.h"
+#include "TMP117Check.h"
+
+static uint64_t timeUs;                   // simulated time
+static uint32_t coarseClock(void) { return timeUs / 1000; }
+
+static uint16_t days;
+
+static void emit(uint8_t, TMP117Rollup::TMP117_level level, const TMP117_bucket &b) {
+  if (level != TMP117Rollup::day)
+    return;
+  check(b.start == days * 86400ul && b.count == 12, "day %u: start %lus, %lu samples", days, (unsigned long)b.start,
+        (unsigned long)b.count);
+  days++;
+}
+
+int main() {
+  TMP117SampleTime::setClock(coarseClock);
+  TMP117Rollup rollup(emit);
+
+  for (uint32_t i = 0; i < 60 * 12; i++) {
+    timeUs = (uint64_t)i * 7200 * 1000000 + 1234567;     // 2 hours, with some offset
+    TMP117_sample s = { 0, 0, TMP117_temp(2560 + i % 12), (uint32_t)timeUs };
+    rollup.onSample(s);
+  }
+  rollup.flush();
+
+  printf("%u day buckets\n", days);
+  check(days == 60, "60 day buckets");
+  return checkResult();
+}
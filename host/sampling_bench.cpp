@@ -0,0 +1,231 @@
+/*!
+ * @brief   Host benchmark: adaptive sampling (TMP117Sampler) vs a fixed 60s interval
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Three sensors on the simulated bus see the same week-long profile: a stable site with a slow daily drift, and a
+ * transient every afternoon (sun on the enclosure: +4.7°C within an hour, decaying over hours). Schedules:
+ * - fixed 60s: the example's former fixed interval (One-Shot)
+ * - adaptive: the example's TMP117Sampler (10s - 15min, ~0.1°C per sample, One-Shot)
+ * - adaptive + window: the same sampler reading a sensor in window alert mode (16s cycle, half window
+ *   TMP117Sampler::window()), so a transient wakes the MCU without waiting for the next sample
+ * A second week repeats the profile with fixed intervals at the wake-up budgets of both adaptive schedules.
+ *
+ * Reported per schedule:
+ * - MCU wake-ups: a One-Shot measurement costs two (timer, Data Ready), a window mode reading one (timer or Alert).
+ *   In window mode the sensor itself converts every 16s: ~2.3µA instead of ~0.2µA for One-Shot every 10 minutes
+ *   (datasheet: 135µA active, 1.25µA standby).
+ * - interval while the temperature changes faster than 0.1°C/minute (time resolution of the transients)
+ * - onset delay: time from the start of a transient to the first sample inside it. A rate-driven interval cannot
+ *   anticipate a transient, so the adaptive sampler's delay is bounded by its maximum interval only.
+ * - error of the linear interpolation between samples against the true temperature during transients, mean and
+ *   max. Both are dominated by the onset.
+ * The adaptive sampler alone resolves transients finer than the fixed interval at its budget, but catches them
+ * later, and its interpolation error is larger. Paired with the window alert mode it must beat the fixed interval
+ * at its budget in onset delay and in both errors.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117EventLoop.h"
+#include "TMP117Sampler.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+#define DAYS        7
+#define ONSET       (14 * 3600.0)         // transient start, each day [s]
+
+static double profile(double s) {
+  double day = fmod(s, 86400);
+  double t = 21.0 + 0.5 * sin(2 * M_PI * s / 86400);
+  if (day >= ONSET) {
+    double d = day - ONSET;
+    t += 8.0 * (exp(-d / 10800) - exp(-d / 1800));
+  }
+  return t;
+}
+
+// rate of change [°C/minute]
+static double rate(double s) {
+  return (profile(s + 0.5) - profile(s - 0.5)) * 60;
+}
+
+TMP117Sim deviceFixed(ADD0_TO_GND, PIN_A11, profile, 0.01);
+TMP117Sim deviceAdaptive(ADD0_TO_VCC, PIN_A10, profile, 0.01);
+TMP117Sim deviceWindow(ADD0_TO_SDA, PIN_A9, profile, 0.01);
+TMP117Sim deviceBudget(ADD0_TO_SCL, PIN_A8, profile, 0.01);
+TMP117 sensorFixed(ADD0_TO_GND, PIN_A11);
+TMP117 sensorAdaptive(ADD0_TO_VCC, PIN_A10);
+TMP117 sensorWindow(ADD0_TO_SDA, PIN_A9);
+TMP117 sensorBudget(ADD0_TO_SCL, PIN_A8);
+TMP117SimClock simClock;
+TMP117EventLoop events(simClock);
+TMP117Sampler sampler(10 * 1000, 15 * 60 * 1000, 13);
+TMP117Sampler windowSampler(10 * 1000, 15 * 60 * 1000, 13);
+
+typedef struct {
+  double    time;                         // [s]
+  double    temp;                         // [°C]
+} sample_t;
+
+typedef struct {
+  TMP117    *sensor;
+  uint32_t  interval;                     // [ms]
+  std::vector<sample_t> *samples;
+} fixed_t;
+
+static std::vector<sample_t> fixedSamples, budgetSamples, windowBudgetSamples, adaptiveSamples, windowSamples;
+static fixed_t fixedA = { &sensorFixed, 60000, &fixedSamples };
+static fixed_t fixedB = { &sensorBudget, 0, nullptr };
+static uint32_t end = DAYS * 86400000ul;  // end of the schedules [ms]
+static uint32_t windowReads;              // MCU wake-ups of the window mode schedule
+static int8_t windowTimer = -1;
+
+static void measureFixedA(void) { fixedA.sensor->startConversion(); }
+static void measureFixedB(void) { fixedB.sensor->startConversion(); }
+static void measureAdaptive(void) { sensorAdaptive.startConversion(); }
+
+static void fixedReady(fixed_t &f, void (*measure)(void)) {
+  sample_t x = { TMP117Sim::time() / 1e6, f.sensor->getTemperature(T_NOW).raw() / 128.0 };
+  f.samples->push_back(x);
+  if (millis() + f.interval < end)
+    events.after(f.interval, measure);
+}
+
+static void fixedReadyA(TMP117 &) { fixedReady(fixedA, measureFixedA); }
+static void fixedReadyB(TMP117 &) { fixedReady(fixedB, measureFixedB); }
+
+static void adaptiveReady(TMP117 &s) {
+  int16_t raw = s.getTemperature(T_NOW).raw();
+  sample_t x = { TMP117Sim::time() / 1e6, raw / 128.0 };
+  adaptiveSamples.push_back(x);
+  uint32_t next = sampler.update(raw, millis());
+  if (millis() + next < end)
+    events.after(next, measureAdaptive);
+}
+
+static void readWindow(void);
+
+// Alert or timer: the reading re-centers the window, the next timer read follows the sampler
+static void windowReady(TMP117 &s) {
+  int16_t raw = s.getTemperature(T_NOW).raw();
+  sample_t x = { TMP117Sim::time() / 1e6, raw / 128.0 };
+  windowSamples.push_back(x);
+  windowReads++;
+  uint32_t next = windowSampler.update(raw, millis());
+  if (windowTimer >= 0)
+    events.cancel(windowTimer);
+  windowTimer = millis() + next < end ? events.after(next, readWindow) : -1;
+}
+
+static void readWindow(void) {
+  uint32_t serviced = 0;
+  windowTimer = -1;
+  sensorWindow.readSensor(&serviced);
+  windowReady(sensorWindow);
+}
+
+typedef struct {
+  double    interval;                     // mean interval during transients [s]
+  double    onset;                        // max. onset delay [s]
+  double    errMean;                      // mean interpolation error during transients [°C]
+  double    errMax;                       // max. interpolation error during transients [°C]
+} result_t;
+
+static result_t evaluate(const std::vector<sample_t> &v) {
+  result_t r = { 0, 0, 0, 0 };
+  uint32_t inside = 0, seconds = 0;
+  size_t k = 0;
+
+  for (size_t i = 0; i < v.size(); i++)
+    inside += fabs(rate(v[i].time)) > 0.1;
+  for (uint32_t s = (uint32_t)v.front().time + 1; s < v.back().time; s++) {
+    while (v[k + 1].time < s)
+      k++;
+    double f = (s - v[k].time) / (v[k + 1].time - v[k].time);
+    double err = fabs(v[k].temp + f * (v[k + 1].temp - v[k].temp) - profile(s));
+    if (fabs(rate(s)) > 0.1) {
+      seconds++;
+      r.errMean += err;
+      if (err > r.errMax)
+        r.errMax = err;
+    }
+  }
+  r.interval = inside ? (double)seconds / inside : 0;
+  r.errMean = seconds ? r.errMean / seconds : 0;
+
+  for (uint32_t d = v.front().time / 86400; d < v.back().time / 86400; d++) {
+    double start = d * 86400.0 + ONSET;
+    while (start < v.back().time && fabs(rate(start)) <= 0.1)
+      start++;
+    for (size_t i = 0; i < v.size(); i++)
+      if (v[i].time >= start) {
+        if (v[i].time - start > r.onset)
+          r.onset = v[i].time - start;
+        break;
+      }
+  }
+  return r;
+}
+
+static void report(const char *name, uint32_t wakeups, const result_t &r) {
+  printf("%-17s %5lu wake-ups, transients: interval %5.1fs, onset delay max %4.0fs, error %.3f°C (max. %.3f°C)\n",
+         name, (unsigned long)wakeups, r.interval, r.onset, r.errMean, r.errMax);
+}
+
+int main() {
+  sensorFixed.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  sensorAdaptive.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  sensorBudget.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+  sensorWindow.initWindow(TMP117::avg8, TMP117::conv_16s, TMP117_temp(windowSampler.window()), 0);
+  events.watch(sensorFixed, fixedReadyA);
+  events.watch(sensorBudget, fixedReadyB);
+  events.watch(sensorAdaptive, adaptiveReady);
+  events.watch(sensorWindow, windowReady);
+  events.every(3600000, nullptr); // hourly wake-up to end each week in time
+  measureFixedA();
+  measureAdaptive();
+  while (millis() < end + 60000)
+    events.run();
+  sensorWindow.initSetup(TMP117::shutdown, TMP117::avg8, false, 0); // stop the continuous conversions
+
+  // second week: fixed intervals at the adaptive schedules' budgets
+  fixedA.interval = DAYS * 86400000ul / adaptiveSamples.size();
+  fixedA.samples = &budgetSamples;
+  fixedB.interval = 2 * DAYS * 86400000ul / windowReads;
+  fixedB.samples = &windowBudgetSamples;
+  end += DAYS * 86400000ul;
+  measureFixedA();
+  measureFixedB();
+  while (millis() < end + 60000)
+    events.run();
+
+  result_t f = evaluate(fixedSamples), b = evaluate(budgetSamples), a = evaluate(adaptiveSamples);
+  result_t wb = evaluate(windowBudgetSamples), w = evaluate(windowSamples);
+  char name[2][20];
+  snprintf(name[0], sizeof(name[0]), "fixed %lus", (unsigned long)fixedA.interval / 1000);
+  snprintf(name[1], sizeof(name[1]), "fixed %lus", (unsigned long)fixedB.interval / 1000);
+  printf("%u days, transient: rate above 0.1°C/minute\n", DAYS);
+  report("fixed 60s", 2 * fixedSamples.size(), f);
+  report("adaptive", 2 * adaptiveSamples.size(), a);
+  report(name[0], 2 * budgetSamples.size(), b);
+  report("adaptive + window", windowReads, w);
+  report(name[1], 2 * windowBudgetSamples.size(), wb);
+  printf("vs fixed 60s: %.1fx fewer wake-ups adaptive, %.1fx adaptive + window\n",
+         (double)fixedSamples.size() / adaptiveSamples.size(), 2.0 * fixedSamples.size() / windowReads);
+
+  check(adaptiveSamples.size() * 3 <= fixedSamples.size(), "adaptive sampling does not cut wake-ups several-fold");
+  check(windowReads * 3 <= 2 * fixedSamples.size(), "adaptive + window does not cut wake-ups several-fold");
+  check(a.interval * 2 <= b.interval,
+        "adaptive sampling does not resolve transients finer than a fixed interval at the same budget");
+  check(a.onset <= 15 * 60, "onset delay exceeds the maximum interval");
+  check(w.onset < wb.onset, "adaptive + window: onset delay %.0fs, fixed at the same budget %.0fs", w.onset, wb.onset);
+  check(w.errMean < wb.errMean, "adaptive + window: mean error %.3f°C, fixed at the same budget %.3f°C", w.errMean,
+        wb.errMean);
+  check(w.errMax < wb.errMax, "adaptive + window: max. error %.3f°C, fixed at the same budget %.3f°C", w.errMax,
+        wb.errMax);
+  return checkResult();
+}
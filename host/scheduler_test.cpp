@@ -0,0 +1,57 @@
+/*!
+ * @brief   Host test: EDF scheduler with late processing
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Two sensors with different periods and deadlines. The application processes each wake-up 3ms late, and is not
+ * woken by the Data Ready interrupts: conversions complete on time, so no deadline may be counted as missed.
+ * A third sensor that is too slow for its deadline must be reported.
+ */
+
+#include <stdio.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Scheduler.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double room(double) { return 21.0; }
+
+TMP117Sim device0(ADD0_TO_GND, PIN_A10, room);
+TMP117Sim device1(ADD0_TO_VCC, PIN_A11, room);
+TMP117Sim device2(ADD0_TO_SDA, 12, room);
+TMP117 sensor0(ADD0_TO_GND, PIN_A10);
+TMP117 sensor1(ADD0_TO_VCC, PIN_A11);
+TMP117 sensor2(ADD0_TO_SDA, 12);
+TMP117Scheduler<3> scheduler(50);
+TMP117CompletionSet<3> serviced;
+
+int main() {
+  uint16_t reads[3] = { 0 };
+
+  sensor0.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);   // 125ms conversions
+  sensor1.initSetup(TMP117::shutdown, TMP117::no_avg, false, 1); // 16ms
+  sensor2.initSetup(TMP117::shutdown, TMP117::avg8, false, 2);
+  device2.setLate(200000);                                       // Data Ready 200ms late
+  scheduler.add(sensor0, 2000, 200, millis());
+  scheduler.add(sensor1, 500, 50, millis());
+  scheduler.add(sensor2, 5000, 200, millis());
+
+  while (millis() < 60000) {
+    serviced.clearAll();
+    uint32_t wakeup = scheduler.run(millis(), serviced);
+    for (uint8_t i = 0; i < 3; i++)
+      reads[i] += serviced.test(i);
+    uint64_t until = ((uint64_t)wakeup + 3) * 1000; // process 3ms late
+    while (TMP117Sim::time() < until)
+      TMP117Sim::sleep(until);
+  }
+
+  printf("reads %u/%u/%u, missed %u/%u/%u, utilization %u‰ (demand %u‰)\n", reads[0], reads[1], reads[2],
+         scheduler.missed(0), scheduler.missed(1), scheduler.missed(2), scheduler.utilization(millis()),
+         scheduler.demand());
+  check(!scheduler.missed(0) && !scheduler.missed(1) && reads[0] >= 29 && reads[1] >= 119,
+        "on-time conversions counted as missed");
+  check(scheduler.missed(2) == 12 && !reads[2], "late sensor not reported");
+  return checkResult();
+}
@@ -0,0 +1,73 @@
+/*!
+ * @brief   Host test: settled temperature prediction (block-sum Aitken) on noisy step responses
+ *
+ * @license MIT License (see license.txt)
+ *
+ * A probe moved from 20°C to 30°C settles with τ = 120s, sampled every 10s with 0.05°C noise. 500 runs each:
+ * - K = 4: three blocks of 4 samples, the prediction after 0.9τ must be 5x closer to 30°C than the reading
+ * - the same 12 samples through K = 1 (three single samples 10s apart, extrapolating further) must be noisier
+ * - after settling, the prediction falls back to the latest sample
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Settle.h"
+#include "TMP117Check.h"
+
+#define RUNS        500
+#define TAU         120.0                 // [s]
+#define INTERVAL    10                    // [s]
+
+static uint64_t random_ = 4711;
+
+static double gaussian(void) {
+  double u[2];
+  for (uint8_t i = 0; i < 2; i++) {
+    random_ = random_ * 6364136223846793005ull + 1442695040888963407ull;
+    u[i] = ((random_ >> 11) + 0.5) / 9007199254740992.0;
+  }
+  return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+}
+
+static int16_t sample(uint32_t i) {
+  return lround((30.0 - 10.0 * exp(-(double)i * INTERVAL / TAU) + 0.05 * gaussian()) * 128);
+}
+
+int main() {
+  double err1 = 0, err4 = 0, errRaw = 0, settled = 0;
+  uint32_t extrapolated1 = 0, extrapolated4 = 0;
+
+  for (uint16_t r = 0; r < RUNS; r++) {
+    TMP117Settle<1> single;
+    TMP117Settle<4> block;
+    for (uint32_t i = 0; i < 12; i++) {
+      int16_t raw = sample(i);
+      single.add(raw, i * INTERVAL * 1000);
+      block.add(raw, i * INTERVAL * 1000);
+      if (i == 11)
+        errRaw += pow(raw / 128.0 - 30, 2);
+    }
+    extrapolated1 += single.extrapolated();
+    extrapolated4 += block.extrapolated();
+    err1 += pow(single.predicted().raw() / 128.0 - 30, 2);
+    err4 += pow(block.predicted().raw() / 128.0 - 30, 2);
+
+    for (uint32_t i = 12; i < 120; i++)
+      block.add(sample(i), i * INTERVAL * 1000);
+    settled += !block.extrapolated();
+  }
+  err1 = sqrt(err1 / RUNS);
+  err4 = sqrt(err4 / RUNS);
+  errRaw = sqrt(errRaw / RUNS);
+  printf("after 110s (0.9τ): reading off by %.3f°C, predicted off by %.3f°C rms (K=4, %u%% extrapolated),"
+         " %.3f°C rms with single samples (K=1, %u%%)\n", errRaw, err4, (unsigned)(extrapolated4 * 100 / RUNS), err1,
+         (unsigned)(extrapolated1 * 100 / RUNS));
+  printf("settled: latest sample in %u%% of the runs\n", (unsigned)(settled * 100 / RUNS));
+
+  check(err4 * 5 <= errRaw && extrapolated4 >= RUNS * 9 / 10, "block-sum prediction not usable before settling");
+  check(err4 < err1, "block sums do not reduce the prediction noise");
+  check(settled >= RUNS * 9 / 10, "extrapolating noise after settling");
+  return checkResult();
+}
@@ -0,0 +1,86 @@
+/*!
+ * @brief   Host test: consistent snapshot() while the sensor is being read
+ *
+ * @license MIT License (see license.txt)
+ *
+ * The reading thread services a sensor in continuous mode (15.5ms cycle, a noisy temperature swing, so actual,
+ * min, max and time all change) and records what it published under each sequence number. A second thread calls
+ * snapshot() as fast as it can, as an ISR or another core would (each read waits until the reader has seen the
+ * previous one, so that all updates overlap with copies). Every snapshot must equal the record published under
+ * its sequence number - a torn copy mixes fields of two updates - and sequence numbers must count the reads.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+#define READS       20000
+
+static double swing(double s) { return 20.0 + 5.0 * sin(s / 10); }
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, swing, 0.05);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+static TMP117_snapshot published[READS + 2];
+static std::atomic<bool> done(false);
+static std::atomic<uint32_t> observed(0);  // latest sequence # seen by the reader
+
+static bool same(const TMP117_snapshot &a, const TMP117_snapshot &b) {
+  return a.actual == b.actual && a.min == b.min && a.max == b.max && a.sequence == b.sequence &&
+         a.timestamp == b.timestamp;
+}
+
+int main() {
+  sensor.initSetup(TMP117::continuous, TMP117::no_avg, false, 0);
+  uint32_t first = sensor.snapshot().sequence;
+
+  std::vector<TMP117_snapshot> seen;
+  seen.reserve(4 * READS);
+  std::thread reader([&seen]() {
+    while (!done.load()) {
+      TMP117_snapshot s = sensor.snapshot();
+      if ((seen.empty() || !same(s, seen.back())) && seen.size() < seen.capacity()) // each update, and any torn copy
+        seen.push_back(s);
+      if (observed.exchange(s.sequence) != s.sequence)
+        std::this_thread::yield(); // single core host: let the reading thread continue
+    }
+  });
+
+  uint32_t serviced = 0, reads = 0, counted = 1;
+  while (reads < READS) {
+    TMP117Sim::sleep(TMP117Sim::time() + 100000);
+    if (sensor.service(&serviced)) {
+      TMP117_snapshot s = sensor.snapshot(); // only this thread writes: the record just published
+      counted &= s.sequence == first + ++reads && s.actual == sensor.getTemperature(T_NOW) &&
+                 s.min == sensor.getTemperature(T_MIN) && s.max == sensor.getTemperature(T_MAX) &&
+                 s.timestamp == sensor.sample().timestamp;
+      if (s.sequence - first < READS + 2)
+        published[s.sequence - first] = s;
+      while (observed.load() != s.sequence) // pace the reads to the reader, which keeps copying during the next one
+        std::this_thread::yield();
+    }
+  }
+  done.store(true);
+  reader.join();
+
+  uint32_t torn = 0, checked = 0, updates = 0;
+  for (size_t i = 0; i < seen.size(); i++) {
+    uint32_t k = seen[i].sequence - first;
+    if (k == 0 || k > READS)
+      continue;
+    checked++;
+    updates += i == 0 || seen[i].sequence != seen[i - 1].sequence;
+    torn += !same(seen[i], published[k]);
+  }
+  printf("%u reads, %u snapshots checked (%u different updates), %u torn\n", (unsigned)reads, (unsigned)checked,
+         (unsigned)updates, (unsigned)torn);
+  check(counted, "sequence number not counting the reads, or snapshot differs from the driver state");
+  check(updates >= READS / 2, "reader thread starved");
+  check(torn == 0, "torn snapshots");
+  return checkResult();
+}
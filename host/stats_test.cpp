@@ -0,0 +1,109 @@
+/*!
+ * @brief   Host test: running statistics (integer Welford) against a double reference, and takeStats()
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. 100000 noisy samples around 20°C: mean and variance against the two-pass double computation. The Q12 mean
+ *    accumulates rounding errors of 1/8192 count per sample as a random walk: well within 0.05 counts (0.4m°C).
+ * 2. The full raw range (alternating -256°C / +255.99°C): mean, and the variance saturating instead of wrapping.
+ * 3. merge() of two intervals equals the statistics of all samples; merging an empty interval changes nothing.
+ * 4. takeStats() of a sensor: statistics of the samples read since the previous call, then a new interval.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <vector>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static uint64_t random_ = 2024;
+
+static double gaussian(void) {
+  double u[2];
+  for (uint8_t i = 0; i < 2; i++) {
+    random_ = random_ * 6364136223846793005ull + 1442695040888963407ull;
+    u[i] = ((random_ >> 11) + 0.5) / 9007199254740992.0;
+  }
+  return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+}
+
+static double room(double s) { return 21.0 + 0.01 * s; }
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, room, 0.1);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+
+// two-pass reference: mean [raw counts], sample variance [raw counts²]
+static void reference(const std::vector<int16_t> &x, double &mean, double &variance) {
+  mean = variance = 0;
+  for (size_t i = 0; i < x.size(); i++)
+    mean += x[i];
+  mean /= x.size();
+  for (size_t i = 0; i < x.size(); i++)
+    variance += (x[i] - mean) * (x[i] - mean);
+  variance /= x.size() - 1;
+}
+
+int main() {
+  // 1. noisy samples: 20°C, 0.5°C rms
+  std::vector<int16_t> x;
+  TMP117Stats all, first, second;
+  for (uint32_t i = 0; i < 100000; i++) {
+    int16_t raw = lround((20.0 + 0.5 * gaussian()) * 128);
+    x.push_back(raw);
+    all.add(raw);
+    (i < 30000 ? first : second).add(raw);
+  }
+  double mean, variance;
+  reference(x, mean, variance);
+  printf("noisy:   mean %.4f (ref %.4f) counts, variance %.2f (ref %.2f) counts²\n", all.mean() / 256.0, mean,
+         all.variance() / 256.0, variance);
+  check(all.count() == 100000 && fabs(all.mean() / 256.0 - mean) < 0.05, "mean");
+  check(all.meanTemp().raw() == lround(mean), "meanTemp()");
+  check(fabs(all.variance() / 256.0 - variance) < variance * 0.001, "variance");
+
+  // 2. full range
+  TMP117Stats extreme;
+  for (uint16_t i = 0; i < 1000; i++)
+    extreme.add(i & 1 ? INT16_MAX : INT16_MIN);
+  printf("extreme: mean %.4f counts, variance %lu (saturated)\n", extreme.mean() / 256.0,
+         (unsigned long)extreme.variance());
+  check(fabs(extreme.mean() / 256.0 + 0.5) < 0.01, "mean of the full range");
+  check(extreme.variance() == UINT32_MAX, "variance beyond 32 bits not saturated");
+
+  // 3. merge
+  TMP117Stats merged = first, empty;
+  merged.merge(second);
+  merged.merge(empty);
+  empty.merge(first);
+  printf("merged:  mean %.4f counts, variance %.2f counts²\n", merged.mean() / 256.0, merged.variance() / 256.0);
+  check(merged.count() == all.count() && fabs(merged.mean() / 256.0 - mean) < 0.05 &&
+        fabs((double)merged.variance() - all.variance()) <= all.variance() * 0.0001, "merged intervals");
+  check(empty.count() == first.count() && empty.mean() == first.mean() && empty.variance() == first.variance(),
+        "merge into an empty interval");
+
+  // 4. takeStats(): 50 One-Shot readings, then 10 more
+  sensor.initSetup(TMP117::shutdown, TMP117::no_avg, false, 0);
+  sensor.takeStats();
+  uint32_t serviced = 0;
+  std::vector<int16_t> readings;
+  for (uint8_t i = 0; i < 60; i++) {
+    if (i == 50) {
+      TMP117Stats s = sensor.takeStats();
+      reference(readings, mean, variance);
+      printf("sensor:  %lu readings, mean %.3f (ref %.3f), variance %.2f (ref %.2f), next interval %lu\n",
+             (unsigned long)s.count(), s.mean() / 256.0, mean, s.variance() / 256.0, variance,
+             (unsigned long)sensor.stats().count());
+      check(s.count() == 50 && fabs(s.mean() / 256.0 - mean) < 0.01 && fabs(s.variance() / 256.0 - variance) < 0.01,
+            "takeStats() not the statistics of the readings");
+      check(sensor.stats().count() == 0, "takeStats() does not start a new interval");
+    }
+    sensor.startConversion();
+    while (!sensor.service(&serviced))
+      TMP117Sim::sleep(TMP117Sim::time() + 100000);
+    readings.push_back(sensor.sample().temp.raw());
+  }
+  check(sensor.stats().count() == 10, "readings after takeStats() not counted");
+  return checkResult();
+}
@@ -0,0 +1,97 @@
+/*!
+ * @brief   Host test: sample timestamps at the midpoint of the conversion window
+ *
+ * @license MIT License (see license.txt)
+ *
+ * 1. One-Shot, avg8 (125ms), read by service(): timestamp = Data Ready - 62.5ms = startConversion() + 62.5ms.
+ * 2. A device 20ms late: the Data Ready based timestamp follows the actual conversion, with
+ *    setTimestampCorrection(false) the sample is timestamped at startConversion() + 62.5ms regardless.
+ * 3. Continuous mode: timestamps one cycle apart, each Data Ready - 62.5ms; sample() and snapshot() agree.
+ * 4. readSensor() from the ISR: timestamp = time of the ISR call - 62.5ms.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+#define HALF        62500                 // half the avg8 conversion time [µs]
+
+static double room(double) { return 21.0; }
+
+static uint32_t serviced, isrTime;
+static void readIsr(void);
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, room);
+TMP117Sim isrDevice(ADD0_TO_VCC, PIN_A10, room);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+TMP117 isrSensor(ADD0_TO_VCC, PIN_A10, readIsr, nullptr);
+
+static void readIsr(void) {
+  isrTime = micros();
+  isrSensor.readSensor(&serviced);
+}
+
+/**
+ * @brief One-Shot conversion read by service()
+ *
+ * @returns Sample timestamp relative to the end of startConversion() [µs]
+ */
+static int32_t oneShot(void) {
+  sensor.startConversion();
+  uint32_t started = micros();
+  while (!sensor.service(&serviced))
+    TMP117Sim::sleep(TMP117Sim::time() + 200000);
+  return (int32_t)(sensor.sample().timestamp - started);
+}
+
+int main() {
+  sensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 0);
+
+  // 1. One-Shot
+  int32_t t = oneShot();
+  int32_t fromReady = (int32_t)(sensor.readyTime() - sensor.sample().timestamp);
+  printf("One-Shot:        sample at start %+ldµs, Data Ready %+ldµs\n", (long)t, (long)fromReady);
+  check(fromReady == HALF && abs(t - HALF) <= 5, "One-Shot sample not at the conversion midpoint");
+
+  // 2. late device, with and without correction
+  device.setLate(20000);
+  int32_t corrected = oneShot();
+  sensor.setTimestampCorrection(false);
+  int32_t uncorrected = oneShot();
+  sensor.setTimestampCorrection(true);
+  device.setLate(0);
+  printf("20ms late:       sample at start %+ldµs (Data Ready based), %+ldµs (start based)\n", (long)corrected,
+         (long)uncorrected);
+  check(abs(corrected - (HALF + 20000)) <= 5, "late conversion not timestamped from Data Ready");
+  check(abs(uncorrected - HALF) <= 5, "setTimestampCorrection(false) not timestamped from startConversion()");
+
+  // 3. continuous conversions
+  sensor.initSetup(TMP117::continuous, TMP117::avg8, false, 0);
+  uint32_t previous = 0, reads = 0, cycle = 0, midpoint = 1, agree = 1;
+  while (reads < 5) {
+    TMP117Sim::sleep(TMP117Sim::time() + 2000000);
+    if (sensor.service(&serviced)) {
+      uint32_t ts = sensor.sample().timestamp;
+      midpoint &= sensor.readyTime() - ts == HALF;
+      agree &= sensor.snapshot().timestamp == ts;
+      if (reads++)
+        cycle = ts - previous;
+      previous = ts;
+    }
+  }
+  printf("continuous:      cycle %luµs\n", (unsigned long)cycle);
+  check(midpoint && agree, "continuous samples not at Data Ready - 62.5ms, or sample() and snapshot() differ");
+  check(cycle == 1000000, "continuous timestamps not one cycle (1s POR setting) apart");
+
+  // 4. read from the ISR
+  isrSensor.initSetup(TMP117::shutdown, TMP117::avg8, false, 1);
+  isrSensor.startConversion();
+  TMP117Sim::advance(200000);
+  int32_t fromIsr = (int32_t)(isrTime - isrSensor.sample().timestamp);
+  printf("readSensor() ISR: sample %ldµs before the ISR\n", (long)fromIsr);
+  check(isrTime != 0 && abs(fromIsr - HALF) <= 2, "readSensor() sample not at the conversion midpoint");
+  return checkResult();
+}
@@ -0,0 +1,103 @@
+/*!
+ * @brief   Host test: rate of change (least-squares trend) over a sliding window of samples
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Samples every 10s into a window of 12:
+ * 1. rising and falling ramps of 0.5°C/minute: rate() within 1%, confidence near 1000‰
+ * 2. noise only (20°C, 0.1°C rms): rate near 0, low confidence
+ * 3. a ramp followed by a constant temperature: once the ramp has left the window, rate and confidence are 0
+ * 4. 1ms time units over 2 hours: rate() as precise as with 1s units (not limited by the Q16 slope of 1.07 counts
+ *    per ms), and the epoch moves (x reaches 2^20 units) without disturbing it
+ * 5. fed as a sink with µs timestamps wrapping at 71.6 minutes
+ * 6. less than 2 samples: no rate
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Trend.h"
+#include "TMP117Check.h"
+
+static uint64_t random_ = 99;
+
+static double gaussian(void) {
+  double u[2];
+  for (uint8_t i = 0; i < 2; i++) {
+    random_ = random_ * 6364136223846793005ull + 1442695040888963407ull;
+    u[i] = ((random_ >> 11) + 0.5) / 9007199254740992.0;
+  }
+  return sqrt(-2 * log(u[0])) * cos(2 * M_PI * u[1]);
+}
+
+// temperature [raw counts] of a ramp of mdegPerMin, at t [s]
+static int16_t ramp(int32_t mdegPerMin, uint32_t t) {
+  return lround((20.0 + mdegPerMin / 1000.0 * t / 60.0) * 128);
+}
+
+int main() {
+  // 6. no rate from less than 2 samples
+  TMP117Trend<12> single;
+  check(single.rate() == 0 && single.confidence() == 0, "rate without samples");
+  single.add(2560, 0);
+  check(single.count() == 1 && single.rate() == 0 && single.confidence() == 0, "rate from one sample");
+
+  // 1. ramps
+  TMP117Trend<12> rising, falling;
+  for (uint32_t t = 0; t <= 600; t += 10) {
+    rising.add(ramp(500, t), t * 1000);
+    falling.add(ramp(-500, t), t * 1000);
+  }
+  printf("ramps:   %ld / %ld m°C/min, confidence %u / %u‰\n", (long)rising.rate(), (long)falling.rate(),
+         rising.confidence(), falling.confidence());
+  check(rising.count() == 12 && abs(rising.rate() - 500) <= 5 && rising.confidence() >= 990, "rising ramp");
+  check(abs(falling.rate() + 500) <= 5 && falling.confidence() >= 990, "falling ramp");
+
+  // 2. noise only
+  TMP117Trend<12> noise;
+  int32_t maxRate = 0;
+  uint32_t maxConfidence = 0;
+  for (uint32_t t = 0; t <= 3600; t += 10) {
+    noise.add(lround((20.0 + 0.1 * gaussian()) * 128), t * 1000);
+    if (noise.count() == 12) {
+      if (abs(noise.rate()) > maxRate) maxRate = abs(noise.rate());
+      maxConfidence += noise.confidence();
+    }
+  }
+  maxConfidence /= 350; // mean over the full windows
+  printf("noise:   rate up to %ld m°C/min, mean confidence %u‰\n", (long)maxRate, (unsigned)maxConfidence);
+  check(maxRate < 300 && maxConfidence < 300, "noise taken for a trend");
+
+  // 3. ramp, then constant
+  TMP117Trend<12> settle;
+  for (uint32_t t = 0; t <= 600; t += 10)
+    settle.add(t < 300 ? ramp(500, t) : ramp(500, 300), t * 1000);
+  printf("settled: %ld m°C/min, confidence %u‰\n", (long)settle.rate(), settle.confidence());
+  check(settle.rate() == 0 && settle.confidence() == 0, "ramp still in the window after 12 constant samples");
+
+  // 4. 1ms time units: x reaches 2^20 after 17.5 minutes
+  TMP117Trend<12> fine(1);
+  int32_t worst = 0;
+  for (uint32_t t = 0; t <= 7200; t += 10) {
+    fine.add(ramp(500, t), t * 1000);
+    if (fine.count() == 12 && abs(fine.rate() - 500) > worst)
+      worst = abs(fine.rate() - 500);
+  }
+  printf("1ms:     rate off by up to %ld m°C/min over 2 hours\n", (long)worst);
+  check(worst <= 2, "rate disturbed by moving the epoch, or too coarse in 1ms units");
+
+  // 5. as a sink: µs timestamps from 1 hour before the wrap
+  TMP117Trend<12> sink;
+  worst = 0;
+  for (uint32_t t = 0; t <= 7200; t += 10) {
+    TMP117_sample s = { 0, 0, TMP117_temp(ramp(-500, t)), (uint32_t)(0xFFFFFFFFul - 3600000000ul + t * 1000000ull) };
+    sink.onSample(s);
+    if (sink.count() == 12 && abs(sink.rate() + 500) > worst)
+      worst = abs(sink.rate() + 500);
+  }
+  printf("sink:    rate off by up to %ld m°C/min across the µs timestamp wrap\n", (long)worst);
+  check(worst <= 2, "rate disturbed by the timestamp wrap");
+  return checkResult();
+}
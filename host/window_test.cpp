@@ -0,0 +1,63 @@
+/*!
+ * @brief   Host test: window alert mode with deferred Data Ready handling (dataReady()/service())
+ *
+ * @license MIT License (see license.txt)
+ *
+ * A cold-chain profile: stable for hours, a door opening warms the sensor by 3°C, then it cools down again.
+ * Every excursion must wake the MCU, and each read must re-center the window, so the MCU keeps being woken up
+ * while the temperature moves and sleeps while it is stable. The samples flag the crossed limit: above the window
+ * while the door is open, below while cooling down.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117EventLoop.h"
+#include "TMP117Sim.h"
+#include "TMP117Check.h"
+
+static double coldChain(double s) {
+  if (s < 3600)
+    return 4.0;
+  return 4.0 + 3.0 * exp(-(s - 3600) / 900) * (1 - exp(-(s - 3600) / 60)); // door opened at 1h
+}
+
+TMP117Sim device(ADD0_TO_GND, PIN_A11, coldChain);
+TMP117 sensor(ADD0_TO_GND, PIN_A11);
+TMP117SimClock clock_;
+TMP117EventLoop events(clock_);
+
+static uint32_t wakeups[4];               // reads per hour
+static uint32_t above, below, both;       // window crossings
+
+static void onSample(TMP117 &s) {
+  uint32_t h = millis() / 3600000;
+  if (h < 4)
+    wakeups[h]++;
+  uint8_t flags = s.sample().flags & (TMP117_ABOVE_WINDOW | TMP117_BELOW_WINDOW);
+  both += flags == (TMP117_ABOVE_WINDOW | TMP117_BELOW_WINDOW);
+  above += flags == TMP117_ABOVE_WINDOW;
+  below += flags == TMP117_BELOW_WINDOW;
+}
+
+int main() {
+  sensor.initWindow(TMP117::avg8, TMP117::conv_16s, TMP117_temp::fromMilli(250), 0);
+  events.watch(sensor, onSample);
+  events.every(3600000, nullptr); // hourly wake-up to end the test in time
+  while (millis() < 4 * 3600000ul)
+    events.run();
+
+  int16_t last = sensor.getTemperature(T_NOW).raw();
+  int16_t actual = lround(coldChain(TMP117Sim::time() / 1e6) * 128);
+  printf("reads per hour: %u %u %u %u, %u conversions\n", wakeups[0], wakeups[1], wakeups[2], wakeups[3], device.conversions());
+  printf("%u reads above, %u below the window, %u initial\n", above, below, both);
+  printf("last read %.3f°C, actual %.3f°C\n", last / 128.0, actual / 128.0);
+
+  check(wakeups[0] == 1 && wakeups[1] >= 10 && wakeups[1] + wakeups[2] + wakeups[3] <= device.conversions() / 10,
+        "MCU not woken for each excursion only");
+  check(both == 1 && above >= 4 && below >= 4 && above + below + both == wakeups[0] + wakeups[1] + wakeups[2] + wakeups[3],
+        "crossed window limit not flagged");
+  check(abs(last - actual) <= 32 + 2, "window not re-centered"); // within the window (±0.25°C)
+  return checkResult();
+}
@@ -14,8 +14,10 @@ typedef enum {
   E_NO_DATA = 8,                          // application did not receive data from all sensors
 } nodeError_t; 
 
+#include "TMP117Temperature.h"
+
 void StartTempSensor(void);
-void TempSensorReady(void);
+void PrintTemperature(TMP117_temp);
 void Error(nodeError_t);
 
 #endif // \TMP117_EXAMPLE_H
\ No newline at end of file
@@ -19,7 +19,12 @@
  * - Temperature data available after a One-Shot conversion:
  *    . Actual temperature
  *    . Min / Max temperature(s)
- * - Data Ready callback
+ * - Data Ready callback, optionally split into a minimal ISR (dataReady) and task-context read (service)
+ * - Data Ready interrupt dispatch to the sensor object, no per-sensor ISR required
+ * - Alert-to-data latency and read duration histograms
+ * - Samples timestamped at the conversion midpoint
+ * - Running statistics (count, mean, variance) per reporting interval
+ * - Sample stream to attached sinks (filters, aggregators)
  * - Uses shutdown mode to minimize power consumption (250nA)
  * - Power-On Reset (POR) setting for production use reducing software initialization overhead
  * - Error feedback after EEPROM write failure
@@ -29,6 +34,23 @@
 #include <Wire.h>
 #include "tmp117_example.h"
 #include "TMP117.h"
+#include "TMP117Completion.h"
+
+static_assert(TMP117_MAX_ALERTS <= 16, "dispatch table supports up to 16 Alert pins");
+
+TMP117 * TMP117::dispatch_[TMP117_MAX_ALERTS];
+uint8_t TMP117::dispatchCount_;
+void (* const TMP117::alertDispatch_[16])(void) = {
+  alertDispatch<0>,  alertDispatch<1>,  alertDispatch<2>,  alertDispatch<3>,
+  alertDispatch<4>,  alertDispatch<5>,  alertDispatch<6>,  alertDispatch<7>,
+  alertDispatch<8>,  alertDispatch<9>,  alertDispatch<10>, alertDispatch<11>,
+  alertDispatch<12>, alertDispatch<13>, alertDispatch<14>, alertDispatch<15>
+};
+
+volatile uint16_t TMP117::burstEdges_;
+volatile uint32_t TMP117::burstEdge_;
+
+uint32_t (*TMP117SampleTime::clock_)(void) = millis;
 
 /**
  * @brief Constructor - setup I2C address, Alert signal pin assignment and interrupt & error callbacks
@@ -38,7 +60,30 @@
  * @param f ISR function handling 'Conversion Ready' Alert event
  * @param e Error handler (optional)
  */
-TMP117::TMP117(const uint8_t a, uint8_t p, void (*f)(void), void (*e)(nodeError_t)) : address_(a), alertPin_(p), isr_(f), error_(e = nullptr) {
+TMP117::TMP117(const uint8_t a, uint8_t p, void (*f)(void), void (*e)(nodeError_t)) : TMP117(a, p, e) {
+  isr_ = f;
+}
+
+/**
+ * @brief Constructor - setup I2C address, Alert signal pin assignment and error callback
+ *
+ * The 'Data Ready' Alert is dispatched to this sensor's dataReady() by the driver, sensor data is read by service().
+ *
+ * @param a Device I2C address [0x48 - 0x4B]
+ * @param p MCU pin to capture TMP117 'Data Ready' at the Alert pin (one sensor per pin)
+ * @param e Error handler (optional)
+ */
+TMP117::TMP117(const uint8_t a, uint8_t p, void (*e)(nodeError_t)) : address_(a), alertPin_(p), isr_(nullptr), error_(e) {
+  noiseBudget_ = 0;
+  ready_ = false;
+  seq_ = 0;
+  slot_ = UINT8_MAX;
+  converting_ = false;
+  correctTime_ = true;
+  windowMode_ = false;
+#if TMP117_LATENCY
+  clearHistograms();
+#endif
 }
 
 /**
@@ -49,15 +94,29 @@ TMP117::TMP117(const uint8_t a, uint8_t p, void (*f)(void), void (*e)(nodeError_
  */
 void TMP117::init(bool saveMinMax, uint8_t sensorId) {
   saveTemp_ = saveMinMax;
+  windowMode_ = false;
   thisSensor_ = sensorId;
+  if (isr_ == nullptr && slot_ == UINT8_MAX && dispatchCount_ < TMP117_MAX_ALERTS) {
+    slot_ = dispatchCount_++;
+    dispatch_[slot_] = this;
+    isr_ = alertDispatch_[slot_];
+  }
   pinMode(alertPin_, INPUT);
-  attachInterrupt(alertPin_, isr_, FALLING);
+  if (isr_ != nullptr)
+    attachInterrupt(alertPin_, isr_, FALLING);
+  else if (error_ != nullptr)
+    error_(nodeError_t(thisSensor_)); // dispatch table full
 
   Wire.begin();
   while (i2cRead2B(eep_ul_r) & eep_busy) ; // POR sequence
 
+  config_ = i2cRead2B(conf_r);
+
   minTemp_ = i2cRead2B(thl_r);
   maxTemp_ = i2cRead2B(tll_r);
+  actualTemp_ = 0;
+  sampleTime_ = 0;
+  publish();
 }
 
 /**
@@ -73,7 +132,36 @@ void TMP117::initSetup(TMP117_mod mode, TMP117_avg averaging, bool saveMinMax, u
 
   // program device confiuration
   config_ = i2cRead2B(conf_r) & TMP117_MOD_CLR_MASK & TMP117_AVG_CLR_MASK;
-  config_ |= mode | averaging | drdy; // (+ set Alert pin to data ready flag)
+  config_ |= (uint16_t)mode | averaging | drdy; // (+ set Alert pin to data ready flag)
+  i2cWrite2B(conf_r, config_);
+}
+
+/**
+ * @brief Window alert mode - continuous conversions, Alert pin only asserted when temperature leaves the window
+ *
+ * THigh/TLow are used as window limits (volatile registers only, EEPROM Min/Max are not updated in this mode).
+ * The initial window is empty, so the first conversion raises an alert which centers the window. Each read
+ * (service() or readSensor()) clears the alert and re-centers the window.
+ *
+ * The settings are volatile: a soft reset, or the general-call reset issued after programming the EEPROM of any
+ * TMP117 on the bus (e.g. saving another sensor's min/max), reloads the POR configuration and ends window mode.
+ * Call initWindow() again after such a reset.
+ *
+ * @param averaging Number of conversion results to be averaged [NO_AVG, AVG8, AVG32, AVG64]
+ * @param cycle Conversion cycle time [CONV_15MS ... CONV_16S] (minimum cycle time depends on averaging)
+ * @param window Half window width
+ * @param sensorId Sensor # (0-31) assigned to this sensor
+ */
+void TMP117::initWindow(TMP117_avg averaging, TMP117_conv cycle, TMP117_temp window, uint8_t sensorId) {
+  init(false, sensorId);
+  window_ = window;
+  windowMode_ = true;
+
+  i2cWrite2B(thl_r, 0x8000); // -256°C: first conversion always triggers a high alert
+  i2cWrite2B(tll_r, 0x7FFF);
+
+  config_ = i2cRead2B(conf_r) & TMP117_MOD_CLR_MASK & TMP117_CONV_CLR_MASK & TMP117_AVG_CLR_MASK & TMP117_ALERT_CLR_MASK;
+  config_ |= (uint16_t)continuous | cycle | averaging | alert;
   i2cWrite2B(conf_r, config_);
 }
 
@@ -93,6 +181,7 @@ bool TMP117::initPowerUpSettings(void) {
   bool err = false;
   minTemp_ = 0x6000; // +192°C
   maxTemp_ = 0x8000; // -256°C
+  publish();
 
   if (i2cRead2B(tll_r) != maxTemp_)
     err |= progEeprom(tll_r, maxTemp_);
@@ -104,45 +193,88 @@ bool TMP117::initPowerUpSettings(void) {
   return err;
 }
 
-#if 0 // not used
 /**
- * @brief Set averaging mode (not used)
+ * @brief Set averaging mode
  *
  * @param avgs Number of averages [NO_AVG, AVG8, AVG32, AVG64]
  */
 void TMP117::setAveraging(TMP117_avg avgs) {
-  int16_t config = i2cRead2B(conf_r) & TMP117_AVG_CLR_MASK;
+  config_ = (i2cRead2B(conf_r) & TMP117_AVG_CLR_MASK) | avgs;
  
-  i2cWrite2B(conf_r, conf | avgs);
+  i2cWrite2B(conf_r, config_);
+}
+
+/**
+ * @brief Automatic averaging - select the cheapest averaging mode meeting a noise budget
+ *
+ * Sensor noise is estimated from the sample-to-sample variance, the averaging mode is re-evaluated at each
+ * startConversion() (no additional I2C traffic). Temperature changes between samples add to the observed
+ * variance, so the estimate errs on the side of more averaging.
+ *
+ * @param maxNoise Target noise (rms) per sample in 0.0078125°C per increment, 0: disable
+ */
+void TMP117::setNoiseBudget(uint8_t maxNoise) {
+  noiseBudget_ = maxNoise * maxNoise;
+  noiseVar_ = 0;
+  noiseSamples_ = 0;
 }
 
 /**
- * @brief Set offset temperature (not used)
+ * @brief Set offset temperature (volatile, use progEeprom to make it persistent)
  *
- * @param target Offset temperature in the range of ±256°C
+ * @param offset Offset temperature in the range of ±256°C
  */
-void TMP117::setOffsetTemperature(double offset) {
-  i2cWrite2B(t_offset_r, offset / TMP117_RES);
+void TMP117::setOffsetTemperature(TMP117_temp offset) {
+  i2cWrite2B(t_offset_r, offset.raw());
 }
-#endif // \0
 
 /**
  * @brief Trigger single temperature conversion cycle
+ *
+ * Reading the config register clears Data Ready, so a pending ready event left by a previous conversion (e.g. one
+ * that arrived after its deadline) is dropped: the next service() returns this conversion's result.
  */
 void TMP117::startConversion(void) {
   int16_t config = i2cRead2B(conf_r) & TMP117_MOD_CLR_MASK;
+  ready_ = false;
+
+  if (noiseBudget_) {
+    config = (config & TMP117_AVG_CLR_MASK) | selectAveraging(config);
+    config_ = (config_ & TMP117_AVG_CLR_MASK) | (config & avg64);
+  }
 
   i2cWrite2B(conf_r, config | one_shot);
+  convStart_ = micros();
+  converting_ = true;
+}
+
+/**
+ * @brief One-Shot conversion time for the configured averaging mode
+ *
+ * @returns Conversion time [ms]
+ */
+uint16_t TMP117::conversionTime(void) const {
+  return (conversionTimeUs() + 999) / 1000;
+}
+
+/**
+ * @brief Active conversion time for the configured averaging mode
+ *
+ * @returns Conversion time [µs]
+ */
+uint32_t TMP117::conversionTimeUs(void) const {
+  static const uint32_t convTime[] = { 15500, 125000, 500000, 1000000 }; // no_avg, avg8, avg32, avg64
+  return convTime[(config_ & avg64) >> 5];
 }
 
 /**
  * @brief Pass cached temperature value
  *
  * @param p Temperature parameter [T_NOW, T_MIN, T_MAX]
- * @returns Temperature in 0.0078125°C per increment
+ * @returns Temperature
  */
-int16_t TMP117::getTemperature(par p = T_NOW) {
-  return p == T_MIN ? minTemp_ : p == T_MAX ? maxTemp_ : actualTemp_;
+TMP117_temp TMP117::getTemperature(par p = T_NOW) {
+  return TMP117_temp(p == T_MIN ? minTemp_ : p == T_MAX ? maxTemp_ : actualTemp_);
 }
 
 /**
@@ -151,29 +283,404 @@ int16_t TMP117::getTemperature(par p = T_NOW) {
  * @param sensorsServiced Global status of all sensors - sensor must set 'its' bit when serviced
  * @returns Most recent temperature
  */
-int16_t TMP117::readSensor(uint32_t * const sensorsServiced) {
-  actualTemp_ = i2cRead2B(temp_r);
+TMP117_temp TMP117::readSensor(uint32_t * const sensorsServiced) {
+  int16_t t = readData(micros(), false); // called at the edge from an ISR: no recorded edge time, no latency entry
+  *sensorsServiced |= Sensor_serviced(thisSensor_);
+  return TMP117_temp(t);
+}
+
+/**
+ * @brief Read sensor temperature, update actual and historic min/max values if needed
+ *
+ * @param sensorsServiced Completion set of all sensors - marks this sensor serviced
+ * @returns Most recent temperature
+ */
+TMP117_temp TMP117::readSensor(TMP117Completion &sensorsServiced) {
+  int16_t t = readData(micros(), false); // called at the edge from an ISR: no recorded edge time, no latency entry
+  sensorsServiced.set(thisSensor_);
+  return TMP117_temp(t);
+}
+
+/**
+ * @brief Read sensor temperature, update actual and historic min/max values if needed
+ *
+ * @param time Data Ready time (Alert) [µs]
+ * @param edge True when time is the recorded Alert edge (dataReady()), false for the time of the call
+ * @param flags Sample flags decoded from the conf register (window alert mode), 0 otherwise
+ * @returns Most recent temperature
+ */
+int16_t TMP117::update(uint32_t time, bool edge, uint8_t flags) {
+#if TMP117_LATENCY
+  uint32_t readStart = micros();
+  if (edge)
+    record(latency_, readStart - time);
+#endif
+  int16_t t = i2cRead2B(temp_r);
+
+  // timestamp at the midpoint of the averaging window: One-Shot start + half the conversion time,
+  // or Data Ready - half the conversion time (continuous mode, or One-Shot with correction)
+  uint32_t half = conversionTimeUs() / 2;
+  sampleTime_ = converting_ && !correctTime_ ? convStart_ + half : time - half;
+  converting_ = false;
+  if (noiseBudget_)
+    updateNoise(t);
+  actualTemp_ = t;
+  stats_.add(t);
+  flags_ = flags;
 
   // only update Min / Max when changed at least 6 * 7.8125m°C = .047°C, keeping # EEPROM writes low* and save little energy
   // *) note: storing every .047°C change over a range of 100°C takes 2128 EEPROM writes
   if (actualTemp_ <= minTemp_ - 6) {
     minTemp_ = actualTemp_;
+    flags_ |= TMP117_NEW_MIN;
     if (saveTemp_) 
-      if (progEeprom(thl_r, minTemp_) && error_ != nullptr)
-        error_(nodeError_t(thisSensor_));
+      if (progEeprom(thl_r, minTemp_)) {
+        flags_ |= TMP117_EEPROM_ERR;
+        if (error_ != nullptr)
+          error_(nodeError_t(thisSensor_));
+      }
   }
 
   if (actualTemp_ >= maxTemp_ + 6) {
     maxTemp_ = actualTemp_;
+    flags_ |= TMP117_NEW_MAX;
     if (saveTemp_)
-      if (progEeprom(tll_r, maxTemp_) && error_ != nullptr)
-        error_(nodeError_t(thisSensor_));
+      if (progEeprom(tll_r, maxTemp_)) {
+        flags_ |= TMP117_EEPROM_ERR;
+        if (error_ != nullptr)
+          error_(nodeError_t(thisSensor_));
+      }
   }
 
-  *sensorsServiced |= Sensor_serviced(thisSensor_);
+  publish();
+#if TMP117_LATENCY
+  record(readDuration_, micros() - readStart);
+#endif
+  emit(sample()); // sinks are not part of the read duration
   return actualTemp_;
 }
 
+/**
+ * @brief Most recent sample record
+ *
+ * @returns Sensor id, flags, temperature and sample time
+ */
+TMP117_sample TMP117::sample(void) const {
+  TMP117_sample s = { thisSensor_, flags_, TMP117_temp(actualTemp_), sampleTime_ };
+  return s;
+}
+
+/**
+ * @brief Set the coarse clock of all sample time bases, used to resolve µs timestamp wraps
+ *
+ * millis() by default. When millis() stops during sleep, pass e.g. an RTC based clock. The coarse clock limits the
+ * gaps between samples to 49.7 days.
+ *
+ * @param ms Coarse clock [ms], nullptr: none (gaps limited to 71.6 minutes)
+ */
+void TMP117SampleTime::setClock(uint32_t (*ms)(void)) {
+  clock_ = ms;
+}
+
+/**
+ * @brief Advance the time base to the next sample
+ *
+ * @param us Sample timestamp [µs]
+ * @returns Sample time since the first sample [ms]
+ */
+uint32_t TMP117SampleTime::update(uint32_t us) {
+  uint32_t coarse = clock_ != nullptr ? clock_() : 0;
+  if (started_) {
+    uint64_t d = us - last_;
+    uint64_t c = (uint64_t)(coarse - coarse_) * 1000;
+    if (c > d + (1ul << 31)) // µs timestamp wrapped: add the whole wraps seen by the coarse clock
+      d += ((c - d + (1ul << 31)) >> 32) << 32;
+    d += rest_;
+    time_ += d / 1000;
+    rest_ = d % 1000;
+    d = d / 1000 + ms_;
+    seconds_ += d / 1000;
+    ms_ = d % 1000;
+  }
+  else {
+    rest_ = ms_ = 0;
+    started_ = true;
+  }
+  last_ = us;
+  coarse_ = coarse;
+  return time_;
+}
+
+/**
+ * @brief Consistent actual/min/max temperatures, safe to call from any context (no interrupt masking)
+ *
+ * @returns Temperatures, update sequence # and sample time of the most recent reading
+ */
+TMP117_snapshot TMP117::snapshot(void) const {
+  TMP117_snapshot s;
+  uint32_t seq;
+
+  do {
+    seq = seq_.load(std::memory_order_acquire);
+    s = snap_[seq & 1];
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (seq != seq_.load(std::memory_order_relaxed)); // retry when updated (twice) while copying
+  return s;
+}
+
+/**
+ * @brief Running statistics since the last takeStats()
+ *
+ * @returns Count, mean and variance of the temperature
+ */
+TMP117Stats TMP117::stats(void) const {
+  TMP117Lock lock;
+  return stats_;
+}
+
+/**
+ * @brief Running statistics since the last takeStats(), and start a new reporting interval
+ *
+ * @returns Count, mean and variance of the temperature
+ */
+TMP117Stats TMP117::takeStats(void) {
+  TMP117Lock lock;
+  TMP117Stats s = stats_;
+  stats_.reset();
+  return s;
+}
+
+/**
+ * @brief Publish actual/min/max temperatures for snapshot()
+ *
+ * Writes the unpublished buffer, readers never see a partially updated record.
+ */
+void TMP117::publish(void) {
+  uint32_t seq = seq_.load(std::memory_order_relaxed) + 1;
+  TMP117_snapshot &s = snap_[seq & 1];
+
+  s.actual = TMP117_temp(actualTemp_);
+  s.min = TMP117_temp(minTemp_);
+  s.max = TMP117_temp(maxTemp_);
+  s.sequence = seq;
+  s.timestamp = sampleTime_;
+  seq_.store(seq, std::memory_order_release);
+}
+
+#if TMP117_LATENCY
+/**
+ * @brief Reset latency and read duration histograms
+ */
+void TMP117::clearHistograms(void) {
+  for (uint8_t i = 0; i < TMP117_LATENCY_BUCKETS; i++)
+    latency_.bucket[i] = readDuration_.bucket[i] = 0;
+}
+
+/**
+ * @brief Add time to log-bucket histogram
+ *
+ * @param h Histogram
+ * @param time Time [µs]
+ */
+void TMP117::record(TMP117_histogram &h, uint32_t time) {
+  uint8_t n = 0;
+  while ((time >>= 1) && n < TMP117_LATENCY_BUCKETS - 1)
+    n++;
+  if (h.bucket[n] != UINT16_MAX)
+    h.bucket[n]++;
+}
+#endif
+
+/**
+ * @brief Data Ready interrupt (deferred mode) - only record the ready event, see service()
+ */
+void TMP117::dataReady(void) {
+  readyTime_ = micros();
+  ready_ = true;
+}
+
+/**
+ * @brief Deferred Data Ready handling in task context - read sensor when a ready event is pending
+ *
+ * @param sensorsServiced Global status of all sensors - sensor must set 'its' bit when serviced
+ * @returns True when the sensor was read
+ */
+bool TMP117::service(uint32_t * const sensorsServiced) {
+  if (!ready_)
+    return false;
+
+  ready_ = false;
+  readData(readyTime_, true);
+  *sensorsServiced |= Sensor_serviced(thisSensor_);
+  return true;
+}
+
+/**
+ * @brief Deferred Data Ready handling in task context - read sensor when a ready event is pending
+ *
+ * @param sensorsServiced Completion set of all sensors - marks this sensor serviced
+ * @returns True when the sensor was read
+ */
+bool TMP117::service(TMP117Completion &sensorsServiced) {
+  if (!ready_)
+    return false;
+
+  ready_ = false;
+  readData(readyTime_, true);
+  sensorsServiced.set(thisSensor_);
+  return true;
+}
+
+/**
+ * @brief Capture a burst of samples at the fastest cycle time (continuous mode, no averaging), then shutdown
+ *
+ * The Data Ready interrupt is temporarily redirected to an internal ISR which only timestamps the edge; the
+ * temperature register is read here, in the calling context (no I2C in interrupt context). Between samples the MCU
+ * sleeps until the next interrupt. Min/Max temperatures are not updated. Blocks until all samples are captured or
+ * the burst times out.
+ *
+ * @param buffer Caller-supplied buffer receiving the temperatures
+ * @param samples Number of samples to capture (buffer size)
+ * @param report Achieved cycle time and jitter, compare with TMP117_CYCLE_MIN (optional)
+ * @returns Number of samples captured
+ */
+uint16_t TMP117::burst(TMP117_temp * const buffer, uint16_t samples, TMP117_burst * const report) {
+  uint16_t count = 0, seen = 0;
+  uint32_t first = 0, last = 0, minCycle = UINT32_MAX, maxCycle = 0;
+  burstEdges_ = 0;
+
+  detachInterrupt(alertPin_);
+  attachInterrupt(alertPin_, burstReady, FALLING);
+
+  int16_t config = i2cRead2B(conf_r) & TMP117_MOD_CLR_MASK;
+  i2cWrite2B(conf_r, (config & TMP117_CONV_CLR_MASK & TMP117_AVG_CLR_MASK & TMP117_ALERT_CLR_MASK) | continuous | conv_15ms | no_avg | drdy);
+
+  uint32_t start = millis();
+  uint32_t timeout = (uint32_t)samples * 2 * TMP117_CYCLE_MIN / 1000 + 50;
+  while (count < samples && millis() - start < timeout) {
+    if (burstEdges_ == seen) {
+#if defined(__arm__)
+      __WFI(); // woken by Data Ready, or at the latest by the next SysTick
+#endif
+      continue;
+    }
+    uint32_t edge;
+    do { // edge time of the latest edge, without masking interrupts
+      seen = burstEdges_;
+      edge = burstEdge_;
+    } while (seen != burstEdges_);
+
+    buffer[count] = TMP117_temp(i2cRead2B(temp_r)); // also clears Data Ready
+    if (count == 0)
+      first = edge;
+    else {
+      uint32_t cycle = edge - last;
+      if (cycle < minCycle) minCycle = cycle;
+      if (cycle > maxCycle) maxCycle = cycle;
+    }
+    last = edge;
+    count++;
+  }
+
+  i2cWrite2B(conf_r, config | shutdown);
+  detachInterrupt(alertPin_);
+  if (isr_ != nullptr)
+    attachInterrupt(alertPin_, isr_, FALLING);
+
+  if (report != nullptr) {
+    report->count = count;
+    report->period = count > 1 ? (last - first) / (count - 1) : 0;
+    report->minCycle = count > 1 ? minCycle : 0;
+    report->maxCycle = maxCycle;
+  }
+  return count;
+}
+
+/**
+ * @brief Burst Data Ready interrupt - timestamp the edge only, the sample is read by burst()
+ */
+void TMP117::burstReady(void) {
+  burstEdge_ = micros();
+  burstEdges_ = burstEdges_ + 1;
+}
+
+/**
+ * @brief Read sensor data; in window alert mode also clear the alert and re-center the window on the new reading
+ *
+ * @param time Data Ready time (Alert) [µs]
+ * @param edge True when time is the recorded Alert edge (dataReady()), false for the time of the call
+ * @returns Most recent temperature
+ */
+int16_t TMP117::readData(uint32_t time, bool edge) {
+  if (!windowMode_)
+    return update(time, edge, 0);
+
+  uint16_t conf = i2cRead2B(conf_r); // clear alert flags, releases Alert pin
+  uint8_t flags = (conf & TMP117_HIGH_ALERT ? TMP117_ABOVE_WINDOW : 0) | (conf & TMP117_LOW_ALERT ? TMP117_BELOW_WINDOW : 0);
+  TMP117_temp t = TMP117_temp(update(time, edge, flags));
+  i2cWrite2B(thl_r, (t + window_).raw());
+  i2cWrite2B(tll_r, (t - window_).raw());
+  return t.raw();
+}
+
+/**
+ * @brief Update sample noise estimate (variance without averaging in Q4, 1/16 exponential averaging)
+ *
+ * Each difference is scaled by the averaging modes both samples were taken with, so the estimate is not disturbed
+ * by averaging mode changes.
+ *
+ * @param t New temperature reading
+ */
+void TMP117::updateNoise(int16_t t) {
+  static const uint8_t averages[] = { 1, 8, 32, 64 };
+  uint8_t avg = averages[(config_ & avg64) >> 5];
+  uint8_t prev = noiseAvg_;
+
+  noiseAvg_ = avg;
+  if (noiseSamples_++ == 0)
+    return;
+  if (noiseSamples_ > 16)
+    noiseSamples_ = 16;
+
+  int32_t d = t - actualTemp_;
+  if (d > 1023) d = 1023; // large steps are signal, not noise
+  if (d < -1023) d = -1023;
+  // var(diff) = var(sample) + var(previous sample) = rawVar / avg + rawVar / prev
+  int32_t v = ((uint64_t)(d * d) << 4) * avg * prev / (avg + prev);
+  if (noiseSamples_ == 2)
+    noiseVar_ = v; // seed with the first difference
+  else
+    noiseVar_ += (v - noiseVar_) >> 4;
+}
+
+/**
+ * @brief Select cheapest averaging mode meeting the noise budget
+ *
+ * Hysteresis keeps estimation noise from toggling between two modes: more averaging is selected when the noise
+ * variance exceeds the actual mode's budget by 50%, less averaging when it is at least 1/3 below the cheaper
+ * mode's budget.
+ *
+ * @param config Actual configuration register value
+ * @returns Averaging mode (unchanged until the noise estimate has settled)
+ */
+TMP117::TMP117_avg TMP117::selectAveraging(int16_t config) {
+  static const uint8_t averages[] = { 1, 8, 32, 64 };
+  uint8_t i = (config & avg64) >> 5;
+
+  if (noiseSamples_ < 16)
+    return TMP117_avg(i << 5);
+
+  uint32_t var = noiseVar_;
+  uint32_t budget = (uint32_t)noiseBudget_ << 4;
+  if (var * 2 > budget * averages[i] * 3)
+    while (i < 3 && var > budget * averages[i])
+      i++;
+  else
+    while (i > 0 && var * 3 <= budget * averages[i - 1] * 2)
+      i--;
+  return TMP117_avg(i << 5);
+}
+
 /**
  * @brief Write two bytes (16 bits) to TMP117 register
  *
@@ -4,44 +4,156 @@
 #ifndef _TMP117_H_
 #define _TMP117_H_
 
+#include <atomic>
+#include "TMP117Temperature.h"
+#include "TMP117Stats.h"
+#include "TMP117Sink.h"
+
 #if !defined Sensor_serviced
 #define Sensor_serviced(s) (1u << s)
 #endif
 
+class TMP117Completion;
+class TMP117Measure;
+
 // Address Pin to Slave Address mapping
 #define ADD0_TO_GND             0x48
 #define ADD0_TO_VCC             0x49 // (<-- BlueDot 'as is')
 #define ADD0_TO_SDA             0x4A
 #define ADD0_TO_SCL             0x4B
 
-#define TMP117_RES (double)0.0078125
+#if !defined TMP117_MAX_ALERTS
+#define TMP117_MAX_ALERTS       16     // # Alert pins in dispatch table (SAMD21: 16 external interrupt lines)
+#endif
+
+#if !defined TMP117_LATENCY
+#define TMP117_LATENCY          1      // Alert-to-data latency histograms, set to 0 to disable
+#endif
+#define TMP117_LATENCY_BUCKETS  16     // bucket n: [2^n, 2^(n+1)) µs, last bucket: >= 32.768ms
 
 #define TMP117_MOD_CLR_MASK     0xF3FF 
 #define TMP117_AVG_CLR_MASK     0xFF9F
+#define TMP117_CONV_CLR_MASK    0xFC7F
+#define TMP117_ALERT_CLR_MASK   0xFFEB
 #define TMP117_SOFT_RST         0x0002
 
 #define TMP117_CONF_RD          0x0464 // conf reg readback mask
+#define TMP117_CYCLE_MIN        15500  // datasheet cycle time [µs], no averaging
+#define TMP117_HIGH_ALERT       0x8000 // conf reg flags, cleared on read
+#define TMP117_LOW_ALERT        0x4000
+
+// Sample record flags
+#define TMP117_NEW_MIN          0x01   // sample is a new lowest temperature
+#define TMP117_NEW_MAX          0x02   // sample is a new highest temperature
+#define TMP117_EEPROM_ERR       0x04   // writing min/max to EEPROM failed
+#define TMP117_ABOVE_WINDOW     0x08   // window alert mode: temperature rose above the window (high alert)
+#define TMP117_BELOW_WINDOW     0x10   // window alert mode: temperature fell below the window (low alert)
+
+// Sample record
+typedef struct TMP117_sample {
+  uint8_t   sensor;                       // sensor id
+  uint8_t   flags;                        // TMP117_NEW_MIN, ...
+  TMP117_temp temp;                       // temperature
+  uint32_t  timestamp;                    // sample time, midpoint of the conversion [µs]
+} TMP117_sample;
+
+// Consistent actual/min/max temperature record
+typedef struct {
+  TMP117_temp actual;                     // temperatures
+  TMP117_temp min;
+  TMP117_temp max;
+  uint32_t  sequence;                     // incremented on each update
+  uint32_t  timestamp;                    // sample time, midpoint of the conversion [µs]
+} TMP117_snapshot;
+
+// Log-bucket histogram of times [µs], saturating counters
+typedef struct {
+  uint16_t  bucket[TMP117_LATENCY_BUCKETS];
+} TMP117_histogram;
+
+// Burst capture report (all times in µs)
+typedef struct {
+  uint16_t  count;                        // samples captured
+  uint32_t  period;                       // average cycle time
+  uint32_t  minCycle;                     // shortest cycle time
+  uint32_t  maxCycle;                     // longest cycle time (jitter = maxCycle - minCycle)
+} TMP117_burst;
+
+/**
+ * @brief Continuous time base for sample timestamps
+ *
+ * Extends the 32-bit sample timestamps [µs] to ms since the first sample (wraps after 49.7 days) and whole seconds
+ * (136 years). Gaps of 71.6 minutes or more between samples, where the µs timestamp wraps, are resolved with a
+ * coarse clock (see setClock()).
+ */
+class TMP117SampleTime {
 
-class TMP117 {
+  public:
+              TMP117SampleTime() : time_(0), seconds_(0), started_(false) {}
+
+    uint32_t  update(uint32_t us);
+    uint32_t  seconds(void) const { return seconds_; }    // sample time since the first sample [s]
+    static void setClock(uint32_t (*ms)(void));
+
+  private:
+    uint32_t  time_;
+    uint32_t  seconds_;
+    uint32_t  last_;
+    uint32_t  coarse_;
+    uint16_t  rest_;                      // [µs]
+    uint16_t  ms_;                        // [ms]
+    bool      started_;
+
+    static uint32_t (*clock_)(void);
+};
+
+class TMP117 : public TMP117Source {
 
   public:
               TMP117(const uint8_t, const uint8_t, void (*)(void), void (*)(nodeError_t));
+              TMP117(const uint8_t, const uint8_t, void (*)(nodeError_t) = nullptr);
     // Register Map
     enum TMP117_reg   { temp_r, conf_r, thl_r, tll_r, eep_ul_r, eep1_r, eep2_r, t_offset_r, eep3_r };
     // Supported Config Register Fields
-    enum TMP117_mod   { shutdown = 0x0400, one_shot = 0x0C00 };
+    enum TMP117_mod   { continuous = 0x0000, shutdown = 0x0400, one_shot = 0x0C00 };
     enum TMP117_avg   { no_avg = 0x0000, avg8 = 0x0020, avg32 = 0x0040, avg64 = 0x0060 };
-    enum TMP117_alert { drdy = 0x0004 };
+    enum TMP117_conv  { conv_15ms = 0x0000, conv_125ms = 0x0080, conv_250ms = 0x0100, conv_500ms = 0x0180,
+                        conv_1s = 0x0200, conv_4s = 0x0280, conv_8s = 0x0300, conv_16s = 0x0380 };
+    enum TMP117_alert { alert = 0x0000, drdy = 0x0004 };
 
     void      initSetup(TMP117_mod mode, TMP117_avg averaging, const bool save_min_max_in_eeprom, uint8_t sensor_id);
     void      init(const bool save_min_max_in_eeprom, uint8_t sensor_id);
+    void      initWindow(TMP117_avg averaging, TMP117_conv cycle, TMP117_temp window, uint8_t sensor_id);
     bool      initPowerUpSettings(void);
     void      softReset(void);
     void      setAveraging(TMP117_avg averaging);
+    void      setNoiseBudget(uint8_t max_noise);
     void      startConversion(void);
-    void      setOffsetTemperature(double cal_offset);
-    int16_t   getTemperature(par temp_par);
-    int16_t   readSensor(uint32_t * const sensors_serviced);
+    void      setOffsetTemperature(TMP117_temp cal_offset);
+    TMP117_temp getTemperature(par temp_par);
+    uint8_t   sensorId(void) const { return thisSensor_; }
+    uint16_t  conversionTime(void) const;
+    void      setTimestampCorrection(bool use_ready_time) { correctTime_ = use_ready_time; }
+    TMP117_temp readSensor(uint32_t * const sensors_serviced);
+    TMP117_temp readSensor(TMP117Completion &sensors_serviced);
+    void      dataReady(void);
+    bool      pending(void) const { return ready_; }
+    uint32_t  readyTime(void) const { return readyTime_; }
+    bool      service(uint32_t * const sensors_serviced);
+    bool      service(TMP117Completion &sensors_serviced);
+    TMP117_sample sample(void) const;
+    TMP117_snapshot snapshot(void) const;
+    TMP117Stats stats(void) const;
+    TMP117Stats takeStats(void);
+#if TMP117_LATENCY
+    const TMP117_histogram & latency(void) const { return latency_; }
+    const TMP117_histogram & readDuration(void) const { return readDuration_; }
+    void      clearHistograms(void);
+#endif
+#if defined(__cpp_impl_coroutine)
+    TMP117Measure measure(void);          // see TMP117Async.h
+#endif
+    uint16_t  burst(TMP117_temp * const buffer, uint16_t samples, TMP117_burst * const report = nullptr);
  
   private:
     // EEPROM Unlock Register Fields
@@ -53,13 +165,51 @@ class TMP117 {
     int16_t   actualTemp_;
     int16_t   minTemp_;
     int16_t   maxTemp_;
+    TMP117_temp window_;
+    bool      windowMode_;
     bool      saveTemp_;
     int16_t   config_;
+    uint16_t  noiseBudget_;
+    int32_t   noiseVar_;                  // noise variance without averaging, Q4
+    uint8_t   noiseSamples_;
+    uint8_t   noiseAvg_;                  // # averages of the previous sample
+    uint8_t   flags_;
+    uint32_t  sampleTime_;
+    uint32_t  convStart_;
+    bool      converting_;
+    bool      correctTime_;
+    TMP117Stats stats_;                   // running statistics since takeStats()
+    TMP117_snapshot snap_[2];             // double buffer, snap_[seq_ & 1] is published
+    std::atomic<uint32_t> seq_;
+    volatile bool ready_;
+    volatile uint32_t readyTime_;
     void      (*isr_)(void);
     void      (*error_)(nodeError_t);
 
+    uint8_t   slot_;                      // dispatch table slot
+#if TMP117_LATENCY
+    TMP117_histogram latency_;            // Alert to start of read
+    TMP117_histogram readDuration_;       // start of read to read completed
+#endif
+
+    static TMP117 * dispatch_[TMP117_MAX_ALERTS];
+    static uint8_t dispatchCount_;
+    static void (* const alertDispatch_[16])(void);
+    template <uint8_t S> static void alertDispatch(void) { dispatch_[S]->dataReady(); }
+
+    static volatile uint16_t burstEdges_; // Data Ready edges seen by burstReady()
+    static volatile uint32_t burstEdge_;  // time of the last edge [µs]
+
+    static void burstReady(void);
     uint16_t  i2cRead2B(TMP117_reg sensor_reg);    
     void      i2cWrite2B(TMP117_reg sensor_reg, int16_t new_val);   
     bool      progEeprom(TMP117_reg eeprom_reg, int16_t new_val, int8_t retries = 2);
+    int16_t   readData(uint32_t time, bool edge);
+    int16_t   update(uint32_t time, bool edge, uint8_t flags);
+    void      updateNoise(int16_t new_temp);
+    void      publish(void);
+    uint32_t  conversionTimeUs(void) const;
+    static void record(TMP117_histogram &histogram, uint32_t time);
+    TMP117_avg selectAveraging(int16_t config);
 };
 #endif
\ No newline at end of file
@@ -0,0 +1,186 @@
+/**
+ * @file TMP117Async.h
+ *
+ * @brief C++20 coroutine API for TMP117 sensor reads
+ *
+ * A sensor flow is written as a coroutine returning TMP117Task:
+ *
+ *    TMP117Task flow(TMP117 &sensor) {
+ *      TMP117_sample s = co_await sensor.measure(); // start conversion, suspend until Data Ready, read
+ *      ...
+ *    }
+ *
+ * TMP117Executor runs many flows on one core without blocking. Coroutine frames are taken from a static pool of
+ * TMP117_ASYNC_FRAMES blocks of TMP117_ASYNC_FRAME_SIZE bytes, no heap allocation. Sensors must use deferred
+ * Data Ready handling (dispatch table constructor or dataReady() in the ISR).
+ *
+ * Requires a compiler with C++20 coroutine support, otherwise this header is empty.
+ */
+#ifndef _TMP117_ASYNC_H_
+#define _TMP117_ASYNC_H_
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <stddef.h>
+#include "TMP117.h"
+
+#if !defined TMP117_ASYNC_FRAMES
+#define TMP117_ASYNC_FRAMES     8      // max # concurrent tasks
+#endif
+#if !defined TMP117_ASYNC_FRAME_SIZE
+#define TMP117_ASYNC_FRAME_SIZE 128    // max coroutine frame size [bytes]
+#endif
+
+class TMP117Executor;
+
+class TMP117Task {
+
+  public:
+    struct promise_type {
+      TMP117Executor * executor = nullptr;
+
+      TMP117Task get_return_object(void) noexcept { return TMP117Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+      static TMP117Task get_return_object_on_allocation_failure(void) noexcept { return TMP117Task(nullptr); }
+      std::suspend_always initial_suspend(void) noexcept { return {}; }
+      std::suspend_always final_suspend(void) noexcept { return {}; }
+      void return_void(void) noexcept {}
+      void unhandled_exception(void) noexcept {}
+
+      // static frame pool
+      static void * operator new(size_t size) noexcept {
+        if (size > TMP117_ASYNC_FRAME_SIZE)
+          return nullptr;
+        for (uint8_t i = 0; i < TMP117_ASYNC_FRAMES; i++)
+          if (!used_[i]) {
+            used_[i] = true;
+            return pool_[i].bytes;
+          }
+        return nullptr;
+      }
+      static void operator delete(void * p) noexcept {
+        used_[(frame_t *)p - pool_] = false;
+      }
+
+      private:
+        typedef union { alignas(max_align_t) unsigned char bytes[TMP117_ASYNC_FRAME_SIZE]; } frame_t;
+        static inline frame_t pool_[TMP117_ASYNC_FRAMES];
+        static inline bool used_[TMP117_ASYNC_FRAMES];
+    };
+
+              TMP117Task(TMP117Task &&t) noexcept : handle_(t.handle_) { t.handle_ = nullptr; }
+              ~TMP117Task() { if (handle_) handle_.destroy(); }
+              TMP117Task(const TMP117Task &) = delete;
+    TMP117Task & operator=(const TMP117Task &) = delete;
+
+    bool      valid(void) const { return (bool)handle_; }
+
+  private:
+    friend class TMP117Executor;
+              explicit TMP117Task(std::coroutine_handle<promise_type> h) : handle_(h) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+class TMP117Executor {
+
+  public:
+              TMP117Executor() : count_(0) {}
+
+    /**
+     * @brief Add task, it starts running at the next run()
+     *
+     * @param t Task (coroutine) to run
+     * @returns Error flag when task invalid (frame pool exhausted) or executor full
+     */
+    bool spawn(TMP117Task &&t) {
+      if (!t.valid() || count_ >= TMP117_ASYNC_FRAMES)
+        return true;
+
+      slot_t &s = slots_[count_++];
+      s.handle = t.handle_;
+      s.sensor = nullptr;
+      t.handle_ = nullptr;
+      s.handle.promise().executor = this;
+      return false;
+    }
+
+    /**
+     * @brief Run all tasks that are not waiting, service sensors with pending data and resume their tasks
+     *
+     * @returns Number of tasks left
+     */
+    uint8_t run(void) {
+      for (uint8_t i = 0; i < count_; ) {
+        slot_t &s = slots_[i];
+        if (s.sensor != nullptr) {
+          uint32_t serviced = 0;
+          if (!s.sensor->service(&serviced)) {
+            i++;
+            continue;
+          }
+          s.sensor = nullptr;
+        }
+
+        s.handle.resume();
+        if (s.handle.done()) {
+          s.handle.destroy();
+          s = slots_[--count_];
+        }
+        else
+          i++;
+      }
+      return count_;
+    }
+
+    /**
+     * @returns True when all tasks wait for a sensor (caller may sleep until the next interrupt)
+     */
+    bool idle(void) const {
+      for (uint8_t i = 0; i < count_; i++)
+        if (slots_[i].sensor == nullptr || slots_[i].sensor->pending())
+          return false;
+      return true;
+    }
+
+  private:
+    friend class TMP117Measure;
+
+    typedef struct {
+      std::coroutine_handle<TMP117Task::promise_type> handle;
+      TMP117 *  sensor;                   // sensor waited for, nullptr: ready to run
+    } slot_t;
+
+    slot_t    slots_[TMP117_ASYNC_FRAMES];
+    uint8_t   count_;
+
+    void wait(std::coroutine_handle<TMP117Task::promise_type> h, TMP117 &sensor) {
+      for (uint8_t i = 0; i < count_; i++)
+        if (slots_[i].handle == h)
+          slots_[i].sensor = &sensor;
+    }
+};
+
+// Awaitable one-shot measurement: start conversion, suspend until Data Ready, resume with the new sample
+class TMP117Measure {
+
+  public:
+              explicit TMP117Measure(TMP117 &sensor) : sensor_(sensor) {}
+
+    bool      await_ready(void) const noexcept { return false; }
+    void      await_suspend(std::coroutine_handle<TMP117Task::promise_type> h) {
+                sensor_.startConversion();
+                h.promise().executor->wait(h, sensor_);
+              }
+    TMP117_sample await_resume(void) const { return sensor_.sample(); }
+
+  private:
+    TMP117 &  sensor_;
+};
+
+inline TMP117Measure TMP117::measure(void) {
+  return TMP117Measure(*this);
+}
+
+#endif // __cpp_impl_coroutine
+#endif
@@ -0,0 +1,107 @@
+/**
+ * @file TMP117Barrier.h
+ *
+ * @brief Completion barrier for a sweep of TMP117 conversions with per-sensor deadlines
+ *
+ * Each sensor's deadline is derived from its own conversion time plus a margin. The sweep completes as soon as
+ * every sensor is either serviced or past its deadline, so one slow or dead sensor does not delay the others
+ * beyond its own deadline. Sensors are read in task context (see TMP117::service()).
+ */
+#ifndef _TMP117_BARRIER_H_
+#define _TMP117_BARRIER_H_
+
+#include "TMP117.h"
+#include "TMP117Completion.h"
+
+template <uint16_t N>
+class TMP117Barrier {
+
+  public:
+              TMP117Barrier(uint16_t margin) : margin_(margin), count_(0), active_(false) {}
+
+    /**
+     * @brief Add sensor to the sweep
+     *
+     * @param sensor Initialized sensor, using the Data Ready dispatch (or calling dataReady() from its ISR)
+     * @returns Error flag when barrier full or sensor id out of range
+     */
+    bool add(TMP117 &sensor) {
+      if (count_ >= N || sensor.sensorId() >= N)
+        return true;
+      sensors_[count_++] = &sensor;
+      return false;
+    }
+
+    /**
+     * @brief Start conversions of all sensors and arm their deadlines
+     *
+     * @param now Actual time [ms]
+     */
+    void start(uint32_t now) {
+      serviced_.clearAll();
+      missed_.clearAll();
+      for (uint16_t i = 0; i < count_; i++) {
+        sensors_[i]->startConversion();
+        deadline_[i] = now + sensors_[i]->conversionTime() + margin_;
+      }
+      active_ = true;
+    }
+
+    /**
+     * @brief Service sensors with pending data, check deadlines
+     *
+     * @param now Actual time [ms]
+     * @returns True once, when the sweep completes
+     */
+    bool poll(uint32_t now) {
+      if (!active_)
+        return false;
+
+      bool done = true;
+      for (uint16_t i = 0; i < count_; i++) {
+        uint8_t id = sensors_[i]->sensorId();
+        if (serviced_.test(id) || missed_.test(id))
+          continue;
+        if (sensors_[i]->service(serviced_))
+          continue;
+        if ((int32_t)(now - deadline_[i]) > 0)
+          missed_.set(id);
+        else
+          done = false;
+      }
+      active_ = !done;
+      return done;
+    }
+
+    /**
+     * @returns Earliest deadline of the sensors still pending (time to wake up at the latest) [ms]
+     */
+    uint32_t deadline(void) const {
+      uint32_t t = 0;
+      bool first = true;
+      for (uint16_t i = 0; i < count_; i++) {
+        uint8_t id = sensors_[i]->sensorId();
+        if (!serviced_.test(id) && !missed_.test(id) && (first || (int32_t)(deadline_[i] - t) < 0)) {
+          t = deadline_[i];
+          first = false;
+        }
+      }
+      return t;
+    }
+
+    bool      active(void) const { return active_; }
+    bool      serviced(uint8_t id) const { return serviced_.test(id); }
+    bool      missed(uint8_t id) const { return missed_.test(id); }
+    uint16_t  size(void) const { return count_; }
+    TMP117 &  sensor(uint16_t i) const { return *sensors_[i]; }
+
+  private:
+    const uint16_t margin_;
+    TMP117 *  sensors_[N];
+    uint32_t  deadline_[N];
+    uint16_t  count_;
+    bool      active_;
+    TMP117CompletionSet<N> serviced_;
+    TMP117CompletionSet<N> missed_;
+};
+#endif
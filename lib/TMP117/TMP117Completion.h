@@ -0,0 +1,94 @@
+/**
+ * @file TMP117Completion.h
+ *
+ * @brief Interrupt-safe set of serviced sensors, for any number of sensors
+ *
+ * Replaces the 32-bit sensors serviced mask: set() may be called from an ISR, set/test/clear from any context.
+ * allDone() is a single load.
+ */
+#ifndef _TMP117_COMPLETION_H_
+#define _TMP117_COMPLETION_H_
+
+#include <Arduino.h>
+
+// Interrupt lock, restores previous interrupt state on exit
+class TMP117Lock {
+
+  public:
+#if defined(__arm__)
+              TMP117Lock() : primask_(__get_PRIMASK()) { __disable_irq(); }
+              ~TMP117Lock() { __set_PRIMASK(primask_); }
+  private:
+    const uint32_t primask_;
+#else
+              TMP117Lock() {} // host build: no interrupts
+#endif
+};
+
+class TMP117Completion {
+
+  public:
+    /**
+     * @brief Mark sensor serviced
+     *
+     * @param id Sensor #
+     */
+    void set(uint16_t id) {
+      TMP117Lock lock;
+      uint32_t bit = 1ul << (id & 31);
+      if (id < count_ && !(words_[id >> 5] & bit)) {
+        words_[id >> 5] = words_[id >> 5] | bit;
+        pending_ = pending_ - 1;
+      }
+    }
+
+    /**
+     * @brief Clear serviced status of sensor
+     *
+     * @param id Sensor #
+     */
+    void clear(uint16_t id) {
+      TMP117Lock lock;
+      uint32_t bit = 1ul << (id & 31);
+      if (id < count_ && (words_[id >> 5] & bit)) {
+        words_[id >> 5] = words_[id >> 5] & ~bit;
+        pending_ = pending_ + 1;
+      }
+    }
+
+    /**
+     * @brief Clear serviced status of all sensors (e.g. when starting conversions)
+     */
+    void clearAll(void) {
+      TMP117Lock lock;
+      for (uint16_t i = 0; i < (count_ + 31) / 32; i++)
+        words_[i] = 0;
+      pending_ = count_;
+    }
+
+    bool      test(uint16_t id) const { return id < count_ && (words_[id >> 5] & (1ul << (id & 31))); }
+    bool      allDone(void) const { return pending_ == 0; }
+    uint16_t  pending(void) const { return pending_; }
+    uint16_t  size(void) const { return count_; }
+
+  protected:
+              TMP117Completion(volatile uint32_t * const words, const uint16_t count) : words_(words), count_(count) {
+                clearAll();
+              }
+
+  private:
+    volatile uint32_t * const words_;
+    const uint16_t count_;
+    volatile uint16_t pending_;           // # sensors not serviced
+};
+
+template <uint16_t N>
+class TMP117CompletionSet : public TMP117Completion {
+
+  public:
+              TMP117CompletionSet() : TMP117Completion(words_, N) {}
+
+  private:
+    volatile uint32_t words_[(N + 31) / 32];
+};
+#endif
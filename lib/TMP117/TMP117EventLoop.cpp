@@ -0,0 +1,295 @@
+/*!
+ * @brief   Cooperative event loop for TMP117 'Lite'
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Runs timers and sensor Data Ready events, then sleeps until the next timer is due. Time and sleep are provided
+ * by a pluggable clock: millis() and idle sleep, or the RTC and standby (SAMD21) on the target, a virtual clock on a
+ * host. The clock keeps track of the time spent sleeping, so active vs idle time can be evaluated.
+ */
+
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117EventLoop.h"
+
+/**
+ * @returns Actual time [ms]
+ */
+uint32_t TMP117ArduinoClock::now(void) {
+  return millis();
+}
+
+/**
+ * @brief Sleep until next interrupt (the 1ms system tick at the latest), when wake-up is not due yet
+ *
+ * The wake-up time only decides whether to sleep: the SysTick interrupt ends each sleep within 1ms.
+ *
+ * @param wakeup Wake-up time [ms]
+ */
+void TMP117ArduinoClock::sleepUntil(uint32_t wakeup) {
+  if ((int32_t)(wakeup - millis()) <= 0)
+    return;
+
+  uint32_t start = micros();
+#if defined(__arm__)
+  __WFI();
+#endif
+  idle_ += micros() - start;
+}
+
+#if defined(ARDUINO_ARCH_SAMD)
+/**
+ * @brief Start the RTC: 32-bit counter at 1024Hz, compare 0 interrupt. Run after the sensors' init()
+ *
+ * GCLK2 runs from the 32.768kHz crystal in standby. It clocks the RTC (prescaler 32) and the external interrupt
+ * controller, so the Alert edge wakes up the MCU from standby (attachInterrupt() clocks the EIC from the main clock,
+ * which stops in standby).
+ */
+void TMP117RtcClock::begin(void) {
+  PM->APBAMASK.reg |= PM_APBAMASK_RTC;
+  SYSCTRL->XOSC32K.reg |= SYSCTRL_XOSC32K_RUNSTDBY;
+  NVMCTRL->CTRLB.bit.SLEEPPRM = NVMCTRL_CTRLB_SLEEPPRM_DISABLED_Val; // errata: flash wake-up from standby
+
+  GCLK->GENDIV.reg = GCLK_GENDIV_ID(2) | GCLK_GENDIV_DIV(1);
+  while (GCLK->STATUS.bit.SYNCBUSY) ;
+  GCLK->GENCTRL.reg = GCLK_GENCTRL_ID(2) | GCLK_GENCTRL_SRC_XOSC32K | GCLK_GENCTRL_GENEN | GCLK_GENCTRL_RUNSTDBY;
+  while (GCLK->STATUS.bit.SYNCBUSY) ;
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_ID(RTC_GCLK_ID) | GCLK_CLKCTRL_GEN_GCLK2 | GCLK_CLKCTRL_CLKEN;
+  while (GCLK->STATUS.bit.SYNCBUSY) ;
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_ID(EIC_GCLK_ID) | GCLK_CLKCTRL_GEN_GCLK2 | GCLK_CLKCTRL_CLKEN;
+  while (GCLK->STATUS.bit.SYNCBUSY) ;
+
+  RTC->MODE0.CTRL.reg &= ~RTC_MODE0_CTRL_ENABLE;
+  while (RTC->MODE0.STATUS.bit.SYNCBUSY) ;
+  RTC->MODE0.CTRL.reg = RTC_MODE0_CTRL_SWRST;
+  while (RTC->MODE0.CTRL.reg & RTC_MODE0_CTRL_SWRST) ;
+  RTC->MODE0.CTRL.reg = RTC_MODE0_CTRL_MODE_COUNT32 | RTC_MODE0_CTRL_PRESCALER_DIV32;
+  while (RTC->MODE0.STATUS.bit.SYNCBUSY) ;
+  RTC->MODE0.INTENSET.reg = RTC_MODE0_INTENSET_CMP0;
+  NVIC_EnableIRQ(RTC_IRQn);
+  RTC->MODE0.CTRL.reg |= RTC_MODE0_CTRL_ENABLE;
+  while (RTC->MODE0.STATUS.bit.SYNCBUSY) ;
+
+  count_ = 0;
+  now();
+}
+
+/**
+ * @returns Actual time [ms], from the RTC count (wraps as millis() does); 0 before begin()
+ */
+uint32_t TMP117RtcClock::now(void) {
+  if (!(RTC->MODE0.CTRL.reg & RTC_MODE0_CTRL_ENABLE))
+    return ms_;
+
+  RTC->MODE0.READREQ.reg = RTC_READREQ_RREQ;
+  while (RTC->MODE0.STATUS.bit.SYNCBUSY) ;
+  uint32_t count = RTC->MODE0.COUNT.reg;
+
+  uint64_t t = (uint64_t)(count - count_) * 1000 + rest_; // [1/1024ms]
+  count_ = count;
+  ms_ += t >> 10;
+  rest_ = t & 1023;
+  return ms_;
+}
+
+/**
+ * @brief Sleep in standby until the RTC alarm at the wake-up time or an interrupt
+ *
+ * SysTick does not interrupt the sleep. Wake-ups less than 2ms ahead use idle sleep, as the alarm might pass before
+ * the compare register is written (synchronized to the 32.768kHz clock).
+ *
+ * @param wakeup Wake-up time [ms]
+ */
+void TMP117RtcClock::sleepUntil(uint32_t wakeup) {
+  int32_t delay = wakeup - now();
+  if (delay <= 0)
+    return;
+
+  if (delay < 2) {
+    uint32_t start = micros();
+    __WFI();
+    idle_ += micros() - start;
+    return;
+  }
+
+  uint32_t start = count_;
+  RTC->MODE0.INTFLAG.reg = RTC_MODE0_INTFLAG_CMP0;
+  RTC->MODE0.COMP[0].reg = start + (uint32_t)(((uint64_t)delay * 1024 + 999) / 1000);
+  while (RTC->MODE0.STATUS.bit.SYNCBUSY) ;
+
+  SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+  SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+  __DSB();
+  __WFI();
+  SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+  SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+
+  now();
+  idle_ += (uint64_t)(count_ - start) * 1000000 >> 10;
+}
+
+/**
+ * @brief RTC compare 0 alarm: wake-up only
+ */
+extern "C" void RTC_Handler(void) {
+  RTC->MODE0.INTFLAG.reg = RTC_MODE0_INTFLAG_CMP0;
+}
+#else
+/**
+ * @brief No RTC on this architecture: millis() and idle sleep, as TMP117ArduinoClock
+ */
+void TMP117RtcClock::begin(void) {
+}
+
+/**
+ * @returns Actual time [ms]
+ */
+uint32_t TMP117RtcClock::now(void) {
+  return millis();
+}
+
+/**
+ * @brief Sleep until next interrupt, when wake-up is not due yet
+ *
+ * @param wakeup Wake-up time [ms]
+ */
+void TMP117RtcClock::sleepUntil(uint32_t wakeup) {
+  if ((int32_t)(wakeup - millis()) <= 0)
+    return;
+
+  uint32_t start = micros();
+#if defined(__arm__)
+  __WFI();
+#endif
+  idle_ += micros() - start;
+}
+#endif
+
+/**
+ * @brief Advance virtual time to the wake-up time
+ *
+ * @param wakeup Wake-up time [ms]
+ */
+void TMP117VirtualClock::sleepUntil(uint32_t wakeup) {
+  if ((int32_t)(wakeup - time_) <= 0)
+    return;
+
+  idle_ += (uint64_t)(wakeup - time_) * 1000;
+  time_ = wakeup;
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param clock Clock and sleep provider
+ */
+TMP117EventLoop::TMP117EventLoop(TMP117Clock &clock) : clock_(clock), sensorCount_(0) {
+  for (uint8_t i = 0; i < TMP117_EVENT_TIMERS; i++)
+    timers_[i].active = false;
+  start_ = clock_.now();
+}
+
+/**
+ * @brief Add periodic timer
+ *
+ * @param period Timer period [ms]
+ * @param callback Timer function
+ * @returns Timer id, -1 when no timer available
+ */
+int8_t TMP117EventLoop::every(uint32_t period, void (*callback)(void)) {
+  return addTimer(period, period, callback);
+}
+
+/**
+ * @brief Add one-shot timer
+ *
+ * @param delay Delay [ms]
+ * @param callback Timer function, nullptr: wake-up only
+ * @returns Timer id, -1 when no timer available
+ */
+int8_t TMP117EventLoop::after(uint32_t delay, void (*callback)(void)) {
+  return addTimer(delay, 0, callback);
+}
+
+/**
+ * @brief Stop timer
+ *
+ * @param timer Timer id
+ */
+void TMP117EventLoop::cancel(int8_t timer) {
+  if (timer >= 0 && timer < TMP117_EVENT_TIMERS)
+    timers_[timer].active = false;
+}
+
+/**
+ * @brief Service sensor when Data Ready is pending, then call callback (sensor uses deferred Data Ready handling)
+ *
+ * @param sensor Sensor to watch
+ * @param callback Sensor event function
+ * @returns Error flag when no entry available
+ */
+bool TMP117EventLoop::watch(TMP117 &sensor, void (*callback)(TMP117 &)) {
+  if (sensorCount_ >= TMP117_EVENT_SENSORS)
+    return true;
+
+  sensors_[sensorCount_].sensor = &sensor;
+  sensors_[sensorCount_++].callback = callback;
+  return false;
+}
+
+/**
+ * @brief Run due timers and sensor events, then sleep until the next timer or interrupt
+ */
+void TMP117EventLoop::run(void) {
+  uint32_t now = clock_.now();
+
+  for (uint8_t i = 0; i < TMP117_EVENT_TIMERS; i++) {
+    tmr_t &t = timers_[i];
+    if (t.active && (int32_t)(now - t.due) >= 0) {
+      if (t.period)
+        t.due += t.period;
+      else
+        t.active = false;
+      if (t.callback != nullptr)
+        t.callback();
+    }
+  }
+
+  bool pending = false;
+  for (uint8_t i = 0; i < sensorCount_; i++) {
+    uint32_t serviced = 0;
+    if (sensors_[i].sensor->service(&serviced) && sensors_[i].callback != nullptr)
+      sensors_[i].callback(*sensors_[i].sensor);
+    pending |= sensors_[i].sensor->pending();
+  }
+  if (pending)
+    return;
+
+  // next wake-up
+  now = clock_.now();
+  uint32_t wakeup = now + UINT32_MAX / 2;
+  for (uint8_t i = 0; i < TMP117_EVENT_TIMERS; i++)
+    if (timers_[i].active && (int32_t)(timers_[i].due - wakeup) < 0)
+      wakeup = timers_[i].due;
+  clock_.sleepUntil(wakeup);
+}
+
+/**
+ * @brief Add timer
+ *
+ * @param delay First expiry [ms]
+ * @param period Timer period [ms], 0: one-shot
+ * @param callback Timer function
+ * @returns Timer id, -1 when no timer available
+ */
+int8_t TMP117EventLoop::addTimer(uint32_t delay, uint32_t period, void (*callback)(void)) {
+  for (uint8_t i = 0; i < TMP117_EVENT_TIMERS; i++)
+    if (!timers_[i].active) {
+      timers_[i].due = clock_.now() + delay;
+      timers_[i].period = period;
+      timers_[i].callback = callback;
+      timers_[i].active = true;
+      return i;
+    }
+  return -1;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file TMP117EventLoop.h
+ */
+#ifndef _TMP117_EVENT_LOOP_H_
+#define _TMP117_EVENT_LOOP_H_
+
+#include <stdint.h>
+#include "TMP117.h"
+
+#if !defined TMP117_EVENT_TIMERS
+#define TMP117_EVENT_TIMERS     8
+#endif
+#if !defined TMP117_EVENT_SENSORS
+#define TMP117_EVENT_SENSORS    8
+#endif
+
+// Clock and sleep provider
+class TMP117Clock {
+
+  public:
+    virtual uint32_t now(void) = 0;                       // actual time [ms]
+    virtual void sleepUntil(uint32_t wakeup) = 0;         // sleep until wakeup [ms] or interrupt (may return early)
+    uint32_t  idleTime(void) const { return idle_ / 1000; } // time spent sleeping [ms]
+
+  protected:
+              TMP117Clock() : idle_(0) {}
+    uint64_t  idle_;                                      // [µs]
+};
+
+// Target clock: millis(), idle sleep (WFI) until next interrupt. The wake-up time is not programmed: the 1ms SysTick
+// (which drives millis()) ends every sleep, so the loop wakes up ~1000 times per second and only CPU power is saved.
+// For deep sleep, use TMP117RtcClock.
+class TMP117ArduinoClock : public TMP117Clock {
+
+  public:
+    uint32_t  now(void);
+    void      sleepUntil(uint32_t wakeup);
+};
+
+// SAMD21 deep sleep clock: RTC counter (1024Hz from the 32.768kHz crystal), standby until the RTC compare alarm or
+// an interrupt, SysTick stopped. millis() and micros() do not advance in standby: use now() for time. Call begin()
+// after the sensors' init(). Other architectures: millis() and idle sleep, as TMP117ArduinoClock.
+class TMP117RtcClock : public TMP117Clock {
+
+  public:
+              TMP117RtcClock() : count_(0), ms_(0), rest_(0) {}
+    void      begin(void);
+    uint32_t  now(void);
+    void      sleepUntil(uint32_t wakeup);
+
+  private:
+    uint32_t  count_;                     // RTC count at the last now() [1/1024s]
+    uint32_t  ms_;                        // time at count_ [ms]
+    uint16_t  rest_;                      // fraction of a ms at count_ [1/1024ms]
+};
+
+// Host clock: virtual time, sleeping advances time to the wake-up
+class TMP117VirtualClock : public TMP117Clock {
+
+  public:
+              TMP117VirtualClock(uint32_t start = 0) : time_(start) {}
+    uint32_t  now(void) { return time_; }
+    void      sleepUntil(uint32_t wakeup);
+    void      advance(uint32_t ms) { time_ += ms; }       // simulate active time
+
+  private:
+    uint32_t  time_;
+};
+
+class TMP117EventLoop {
+
+  public:
+              TMP117EventLoop(TMP117Clock &clock);
+
+    int8_t    every(uint32_t period, void (*callback)(void));
+    int8_t    after(uint32_t delay, void (*callback)(void));
+    void      cancel(int8_t timer);
+    bool      watch(TMP117 &sensor, void (*callback)(TMP117 &));
+    void      run(void);
+
+    uint32_t  elapsed(void) { return clock_.now() - start_; }
+    uint32_t  idleTime(void) const { return clock_.idleTime(); }
+
+  private:
+    typedef struct {
+      uint32_t  due;
+      uint32_t  period;                   // 0: one-shot
+      void      (*callback)(void);        // nullptr: wake-up only
+      bool      active;
+    } tmr_t;
+
+    typedef struct {
+      TMP117 *  sensor;
+      void      (*callback)(TMP117 &);
+    } watch_t;
+
+    TMP117Clock & clock_;
+    uint32_t  start_;
+    tmr_t   timers_[TMP117_EVENT_TIMERS];
+    watch_t   sensors_[TMP117_EVENT_SENSORS];
+    uint8_t   sensorCount_;
+
+    int8_t    addTimer(uint32_t delay, uint32_t period, void (*callback)(void));
+};
+#endif
@@ -0,0 +1,175 @@
+/**
+ * @file TMP117Filter.h
+ *
+ * @brief Compile-time composed integer filters on raw TMP117 samples, no dynamic allocation
+ *
+ *    TMP117FilterSink<TMP117Chain<TMP117Median<3>, TMP117Ema<3>, TMP117Decimate<8>>> filtered;
+ *    sensor.attach(filtered);               // sensor -> median-of-3 -> EMA (1/8) -> every 8th sample
+ *    filtered.attach(consumer);             // receives filtered samples
+ *
+ * Each filter provides: bool push(int16_t in, int16_t &out), returning true when an output sample is produced.
+ */
+#ifndef _TMP117_FILTER_H_
+#define _TMP117_FILTER_H_
+
+#include "TMP117.h"
+
+// Exponential moving average, weight 1/2^S
+template <uint8_t S>
+class TMP117Ema {
+
+  public:
+              TMP117Ema() : acc_(0), valid_(false) {}
+
+    bool push(int16_t in, int16_t &out) {
+      if (!valid_) {
+        acc_ = (int32_t)in * (1l << S);
+        valid_ = true;
+      }
+      acc_ += in - ((acc_ + (1l << S >> 1)) >> S);
+      out = (acc_ + (1l << S >> 1)) >> S;
+      return true;
+    }
+
+  private:
+    int32_t   acc_;                       // Q(S)
+    bool      valid_;
+};
+
+// Moving average of the last N samples
+template <uint8_t N>
+class TMP117Boxcar {
+
+  public:
+              TMP117Boxcar() : sum_(0), pos_(0), count_(0) {}
+
+    bool push(int16_t in, int16_t &out) {
+      if (count_ == N)
+        sum_ -= buf_[pos_];
+      else
+        count_++;
+      buf_[pos_] = in;
+      sum_ += in;
+      pos_ = pos_ + 1 < N ? pos_ + 1 : 0;
+      out = (sum_ < 0 ? sum_ - count_ / 2 : sum_ + count_ / 2) / count_;
+      return true;
+    }
+
+  private:
+    int16_t   buf_[N];
+    int32_t   sum_;
+    uint8_t   pos_;
+    uint8_t   count_;
+};
+
+// Median of the last N samples (N odd, small), removes spikes
+template <uint8_t N>
+class TMP117Median {
+    static_assert(N & 1, "median window must be odd");
+
+  public:
+              TMP117Median() : pos_(0), count_(0) {}
+
+    bool push(int16_t in, int16_t &out) {
+      buf_[pos_] = in;
+      pos_ = pos_ + 1 < N ? pos_ + 1 : 0;
+      if (count_ < N)
+        count_++;
+
+      int16_t sorted[N];
+      for (uint8_t i = 0; i < count_; i++) { // insertion sort
+        int16_t v = buf_[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > v; j--)
+          sorted[j] = sorted[j - 1];
+        sorted[j] = v;
+      }
+      out = sorted[count_ / 2];
+      return true;
+    }
+
+  private:
+    int16_t   buf_[N];
+    uint8_t   pos_;
+    uint8_t   count_;
+};
+
+// Pass every Nth sample
+template <uint8_t N>
+class TMP117Decimate {
+
+  public:
+              TMP117Decimate() : count_(0) {}
+
+    bool push(int16_t in, int16_t &out) {
+      if (++count_ < N)
+        return false;
+      count_ = 0;
+      out = in;
+      return true;
+    }
+
+  private:
+    uint8_t   count_;
+};
+
+// Filter chain, applied left to right
+template <typename... F>
+class TMP117Chain;
+
+template <>
+class TMP117Chain<> {
+
+  public:
+    bool push(int16_t in, int16_t &out) {
+      out = in;
+      return true;
+    }
+};
+
+template <typename F, typename... R>
+class TMP117Chain<F, R...> {
+
+  public:
+    bool push(int16_t in, int16_t &out) {
+      int16_t t;
+      return first_.push(in, t) && rest_.push(t, out);
+    }
+
+  private:
+    F         first_;
+    TMP117Chain<R...> rest_;
+};
+
+// Filter as sample stream element: filters samples from a source, passes results to its own sinks. TMP117_NEW_MIN
+// and TMP117_NEW_MAX refer to the filtered stream, the other flags are those of the input sample producing the output.
+template <typename F>
+class TMP117FilterSink : public TMP117Sink, public TMP117Source {
+
+  public:
+              TMP117FilterSink() : min_(INT16_MAX), max_(INT16_MIN) {}
+
+    void onSample(const TMP117_sample &sample) {
+      int16_t raw;
+      if (filter_.push(sample.temp.raw(), raw)) {
+        TMP117_sample s = sample;
+        s.temp = TMP117_temp(raw);
+        s.flags &= ~(TMP117_NEW_MIN | TMP117_NEW_MAX);
+        if (raw < min_) {
+          min_ = raw;
+          s.flags |= TMP117_NEW_MIN;
+        }
+        if (raw > max_) {
+          max_ = raw;
+          s.flags |= TMP117_NEW_MAX;
+        }
+        emit(s);
+      }
+    }
+
+  private:
+    F         filter_;
+    int16_t   min_;                       // lowest / highest filtered temperature
+    int16_t   max_;
+};
+#endif
@@ -0,0 +1,65 @@
+/*!
+ * @brief   Integer-only decimal formatter for TMP117 temperatures
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Renders a temperature (1/128°C per increment) with a fixed number of decimals, exactly rounded (half away from
+ * zero), using 32-bit integer arithmetic only - no floating point or printf.
+ */
+
+#include "TMP117Format.h"
+
+/**
+ * @brief Format temperature as decimal string, e.g. "-12.35"
+ *
+ * @param buffer Caller-supplied output buffer, NUL terminated (empty string when too small)
+ * @param size Buffer size (max. 13 bytes used: sign, 3 digits, point, 7 decimals, NUL)
+ * @param temp Temperature
+ * @param decimals Number of decimals [0-7], 7 decimals is exact
+ * @returns String length, 0 when the buffer is too small
+ */
+size_t tmp117Format(char * const buffer, size_t size, TMP117_temp temp, uint8_t decimals) {
+  static const uint32_t pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+  if (decimals > 7)
+    decimals = 7;
+
+  int16_t raw = temp.raw();
+  uint32_t mag = raw < 0 ? -(int32_t)raw : raw;
+  uint32_t ip = mag >> 7;
+  uint32_t fp = ((mag & 0x7F) * pow10[decimals] + 64) >> 7; // fraction * 10^decimals, rounded
+  if (fp >= pow10[decimals]) {
+    ip++;
+    fp -= pow10[decimals];
+  }
+
+  char digits[3];
+  uint8_t n = 0;
+  do {
+    digits[n++] = '0' + ip % 10;
+    ip /= 10;
+  } while (ip);
+
+  bool neg = raw < 0 && (n > 1 || digits[0] != '0' || fp); // no "-0.00"
+  size_t len = neg + n + (decimals ? decimals + 1 : 0);
+  if (len >= size) {
+    if (size)
+      buffer[0] = '\0';
+    return 0;
+  }
+
+  char *p = buffer;
+  if (neg)
+    *p++ = '-';
+  while (n)
+    *p++ = digits[--n];
+  if (decimals) {
+    *p++ = '.';
+    for (int8_t i = decimals - 1; i >= 0; i--) {
+      p[i] = '0' + fp % 10;
+      fp /= 10;
+    }
+    p += decimals;
+  }
+  *p = '\0';
+  return len;
+}
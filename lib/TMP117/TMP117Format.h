@@ -0,0 +1,11 @@
+/**
+ * @file TMP117Format.h
+ */
+#ifndef _TMP117_FORMAT_H_
+#define _TMP117_FORMAT_H_
+
+#include <stddef.h>
+#include "TMP117Temperature.h"
+
+size_t tmp117Format(char * const buffer, size_t size, TMP117_temp temp, uint8_t decimals = 2);
+#endif
@@ -0,0 +1,112 @@
+/*!
+ * @brief   Streaming quantile estimator (P² algorithm, Jain & Chlamtac) for TMP117 'Lite'
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Estimates one quantile (e.g. P5, P50, P95) of the sample stream in constant memory (N markers) and O(N) per
+ * sample, using integer arithmetic only. Marker heights are kept in Q8 raw counts (1/32768°C).
+ * The first N samples are exact.
+ *
+ * The target quantile is the middle marker. The desired marker positions divide [0, p] and [p, 1] into (N - 1) / 2
+ * equal steps each: 0, p/2, p, (1 + p)/2, 1 for N = 5. They are not stored: after n samples, the desired position
+ * of marker i is (n - 1) * dn[i], with the increment dn[i] in Q16.
+ */
+
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Quantile.h"
+
+/**
+ * @brief Constructor
+ *
+ * @param permille Quantile to estimate [1-999‰], e.g. 950 for P95
+ * @param markers # markers (odd, at least 5)
+ * @param marker Marker storage
+ */
+TMP117QuantileBase::TMP117QuantileBase(uint16_t permille, uint8_t markers, marker_t *marker)
+  : p_(permille < 1 ? 1 : permille > 999 ? 999 : permille), markers_(markers), m_(marker), count_(0) {
+}
+
+/**
+ * @brief Start new estimate (e.g. daily)
+ */
+void TMP117QuantileBase::reset(void) {
+  int32_t p = ((int32_t)p_ << 16) / 1000;
+  uint8_t mid = markers_ / 2;
+
+  count_ = 0;
+  for (uint8_t i = 0; i < markers_; i++) {
+    m_[i].dn = i <= mid ? p * i / mid : p + ((1l << 16) - p) * (i - mid) / mid;
+    m_[i].n = i;
+  }
+}
+
+/**
+ * @brief Add sample
+ *
+ * @param raw Temperature in 0.0078125°C per increment
+ */
+void TMP117QuantileBase::add(int16_t raw) {
+  int32_t x = (int32_t)raw * 256;
+  const uint8_t last = markers_ - 1;
+
+  if (count_ < markers_) { // initial samples: insertion sort
+    uint8_t i = count_++;
+    for (; i > 0 && m_[i - 1].q > x; i--)
+      m_[i].q = m_[i - 1].q;
+    m_[i].q = x;
+    return;
+  }
+  count_++;
+
+  // cell k containing x, adjust extreme markers
+  uint8_t k;
+  if (x < m_[0].q) {
+    m_[0].q = x;
+    k = 0;
+  }
+  else if (x >= m_[last].q) {
+    m_[last].q = x;
+    k = last - 1;
+  }
+  else
+    for (k = 0; k < last - 1 && x >= m_[k + 1].q; k++) ;
+
+  for (uint8_t i = k + 1; i < markers_; i++)
+    m_[i].n++;
+
+  // adjust middle markers
+  for (uint8_t i = 1; i < last; i++) {
+    int64_t d = (int64_t)(count_ - 1) * m_[i].dn - ((int64_t)m_[i].n << 16);
+    int32_t ds;
+    if (d >= (1l << 16) && m_[i + 1].n - m_[i].n > 1)
+      ds = 1;
+    else if (d <= -(1l << 16) && m_[i - 1].n - m_[i].n < -1)
+      ds = -1;
+    else
+      continue;
+
+    // piecewise-parabolic prediction
+    const marker_t &l = m_[i - 1], &c = m_[i], &r = m_[i + 1];
+    int64_t a = (int64_t)(c.n - l.n + ds) * (r.q - c.q) / (r.n - c.n);
+    int64_t b = (int64_t)(r.n - c.n - ds) * (c.q - l.q) / (c.n - l.n);
+    int32_t q = c.q + ds * (a + b) / (r.n - l.n);
+
+    if (l.q < q && q < r.q)
+      m_[i].q = q;
+    else // linear prediction
+      m_[i].q += ds * (m_[i + ds].q - c.q) / (m_[i + ds].n - c.n);
+    m_[i].n += ds;
+  }
+}
+
+/**
+ * @returns Quantile estimate (0 when no samples)
+ */
+TMP117_temp TMP117QuantileBase::value(void) const {
+  if (count_ == 0)
+    return TMP117_temp();
+
+  int32_t q = count_ < markers_ ? m_[(count_ - 1) * p_ / 1000].q : m_[markers_ / 2].q;
+  return TMP117_temp((q + (q < 0 ? -128 : 128)) / 256);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file TMP117Quantile.h
+ *
+ * @brief Streaming quantile estimator (P² algorithm) with N markers
+ *
+ * N = 5 is the classic P² algorithm; more markers (extended P², Raatikainen) cost 12 bytes and a little time per
+ * marker and sample. The error depends on the input: more markers do not reduce it in every case (see
+ * host/quantile_bench.cpp). For a bounded error, use TMP117TempHistogram::quantile().
+ */
+#ifndef _TMP117_QUANTILE_H_
+#define _TMP117_QUANTILE_H_
+
+#include "TMP117.h"
+
+class TMP117QuantileBase : public TMP117Sink {
+
+  public:
+    void      onSample(const TMP117_sample &sample) { add(sample.temp.raw()); }
+    void      add(int16_t raw);
+    void      reset(void);
+    uint32_t  count(void) const { return count_; }
+    TMP117_temp value(void) const;
+
+  protected:
+    typedef struct {
+      int32_t   q;                        // height, Q8 raw counts
+      int32_t   n;                        // position
+      int32_t   dn;                       // desired position increment, Q16
+    } marker_t;
+
+              TMP117QuantileBase(uint16_t permille, uint8_t markers, marker_t *marker);
+
+  private:
+    const uint16_t p_;                    // quantile [‰]
+    const uint8_t markers_;
+    marker_t * const m_;
+    uint32_t  count_;
+};
+
+template <uint8_t N>
+class TMP117QuantileP2 : public TMP117QuantileBase {
+    static_assert(N >= 5 && (N & 1), "marker count must be odd, at least 5");
+
+  public:
+    /**
+     * @param permille Quantile to estimate [1-999‰], e.g. 950 for P95
+     */
+              TMP117QuantileP2(uint16_t permille) : TMP117QuantileBase(permille, N, marker_) { reset(); }
+
+  private:
+    marker_t  marker_[N];
+};
+
+typedef TMP117QuantileP2<5> TMP117Quantile;
+#endif
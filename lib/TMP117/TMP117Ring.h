@@ -0,0 +1,66 @@
+/**
+ * @file TMP117Ring.h
+ *
+ * @brief Lock-free single-producer / single-consumer ring of sample records
+ *
+ * The producer (e.g. the sensor read path, with the ring attached to the sensor as a sink) pushes, the consumer
+ * (e.g. loop()) pops; no interrupt masking needed. When the ring is full the new sample is dropped and counted as
+ * overrun.
+ */
+#ifndef _TMP117_RING_H_
+#define _TMP117_RING_H_
+
+#include <atomic>
+#include "TMP117.h"
+
+template <uint16_t N>
+class TMP117Ring : public TMP117Sink {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "ring capacity must be a power of 2");
+
+  public:
+              TMP117Ring() : head_(0), tail_(0), overruns_(0) {}
+
+    void      onSample(const TMP117_sample &sample) { push(sample); }
+
+    /**
+     * @brief Add sample (producer only)
+     *
+     * @param s Sample record
+     * @returns Error flag when ring full (sample dropped)
+     */
+    bool push(const TMP117_sample &s) {
+      uint16_t head = head_.load(std::memory_order_relaxed);
+      if ((uint16_t)(head - tail_.load(std::memory_order_acquire)) >= N) {
+        overruns_.store(overruns_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return true;
+      }
+      buffer_[head & (N - 1)] = s;
+      head_.store(head + 1, std::memory_order_release);
+      return false;
+    }
+
+    /**
+     * @brief Remove oldest sample (consumer only)
+     *
+     * @param s Receives sample record
+     * @returns True when a sample was available
+     */
+    bool pop(TMP117_sample &s) {
+      uint16_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail == head_.load(std::memory_order_acquire))
+        return false;
+      s = buffer_[tail & (N - 1)];
+      tail_.store(tail + 1, std::memory_order_release);
+      return true;
+    }
+
+    uint16_t  size(void) const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+    uint32_t  overruns(void) const { return overruns_.load(std::memory_order_relaxed); }
+
+  private:
+    TMP117_sample buffer_[N];
+    std::atomic<uint16_t> head_;          // written by producer only
+    std::atomic<uint16_t> tail_;          // written by consumer only
+    std::atomic<uint32_t> overruns_;      // written by producer only
+};
+#endif
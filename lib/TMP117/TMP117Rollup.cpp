@@ -0,0 +1,101 @@
+/*!
+ * @brief   Time-bucketed rollup aggregator (minute/hour/day) for TMP117 'Lite'
+ *
+ * @license MIT License (see license.txt)
+ *
+ * Maintains cascaded min/mean/max buckets in fixed RAM, fed by the sensor's sample stream. A bucket is emitted
+ * when it closes, i.e. when the first sample of a later period arrives (or at flush()), and is then merged into
+ * the next level. Empty periods are not emitted. Only the emitted buckets need to leave the node.
+ */
+
+#include <Arduino.h>
+#include "tmp117_example.h"
+#include "TMP117Rollup.h"
+
+/**
+ * @brief Constructor - setup emit callback and bucket lengths
+ *
+ * @param emit Called for each closed bucket
+ * @param minute Level 0 bucket length [s]
+ * @param hour Level 1 bucket length [s], multiple of level 0
+ * @param day Level 2 bucket length [s], multiple of level 1
+ */
+TMP117Rollup::TMP117Rollup(void (*emit)(uint8_t, TMP117_level, const TMP117_bucket &), uint32_t minute, uint32_t hour, uint32_t day)
+  : emit_(emit), sensor_(0) {
+  length_[0] = minute;
+  length_[1] = hour;
+  length_[2] = day;
+  for (uint8_t i = 0; i < TMP117_ROLLUP_LEVELS; i++)
+    bucket_[i].count = 0;
+}
+
+/**
+ * @brief Add sample from the sensor stream
+ *
+ * @param s Sample record
+ */
+void TMP117Rollup::onSample(const TMP117_sample &s) {
+  sensor_ = s.sensor;
+  time_.update(s.timestamp);
+  add(s.temp.raw(), time_.seconds());
+}
+
+/**
+ * @brief Add sample
+ *
+ * @param raw Temperature in 0.0078125°C per increment
+ * @param now Sample time [s]
+ */
+void TMP117Rollup::add(int16_t raw, uint32_t now) {
+  TMP117_bucket b = { now, 1, raw, raw, raw };
+  merge(0, b);
+}
+
+/**
+ * @brief Close and emit all open buckets (e.g. before shutdown)
+ */
+void TMP117Rollup::flush(void) {
+  for (uint8_t i = 0; i < TMP117_ROLLUP_LEVELS; i++)
+    if (bucket_[i].count)
+      close(i);
+}
+
+/**
+ * @brief Merge aggregate into bucket of level, close the bucket first when the aggregate is in a later period
+ *
+ * @param level Bucket level
+ * @param b Aggregate
+ */
+void TMP117Rollup::merge(uint8_t level, const TMP117_bucket &b) {
+  TMP117_bucket &h = bucket_[level];
+
+  if (h.count && b.start - h.start >= length_[level])
+    close(level);
+
+  if (h.count == 0) {
+    h = b;
+    h.start = b.start - b.start % length_[level];
+    return;
+  }
+
+  int64_t sum = (int64_t)h.sum + b.sum;
+  h.sum = sum > INT32_MAX ? INT32_MAX : sum < INT32_MIN ? INT32_MIN : sum;
+  h.count += b.count;
+  if (b.min < h.min) h.min = b.min;
+  if (b.max > h.max) h.max = b.max;
+}
+
+/**
+ * @brief Emit bucket and merge it into the next level
+ *
+ * @param level Bucket level
+ */
+void TMP117Rollup::close(uint8_t level) {
+  TMP117_bucket b = bucket_[level];
+  bucket_[level].count = 0;
+
+  if (emit_ != nullptr)
+    emit_(sensor_, TMP117_level(level), b);
+  if (level + 1 < TMP117_ROLLUP_LEVELS)
+    merge(level + 1, b);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file TMP117Rollup.h
+ */
+#ifndef _TMP117_ROLLUP_H_
+#define _TMP117_ROLLUP_H_
+
+#include "TMP117.h"
+
+#define TMP117_ROLLUP_LEVELS    3
+
+// Aggregate of one time bucket
+typedef struct {
+  uint32_t  start;                        // bucket start, seconds since first sample
+  uint32_t  count;                        // # samples
+  int32_t   sum;                          // sum of samples (mean = sum / count), saturated
+  int16_t   min;                          // temperatures in 0.0078125°C per increment
+  int16_t   max;
+} TMP117_bucket;
+
+class TMP117Rollup : public TMP117Sink {
+
+  public:
+    enum TMP117_level { minute, hour, day };
+
+              TMP117Rollup(void (*emit)(uint8_t sensor, TMP117_level level, const TMP117_bucket &bucket),
+                           uint32_t minute_length = 60, uint32_t hour_length = 3600, uint32_t day_length = 86400);
+
+    void      onSample(const TMP117_sample &sample);
+    void      add(int16_t raw, uint32_t now);
+    void      flush(void);
+
+  private:
+    void      (*emit_)(uint8_t, TMP117_level, const TMP117_bucket &);
+    uint32_t  length_[TMP117_ROLLUP_LEVELS];
+    TMP117_bucket bucket_[TMP117_ROLLUP_LEVELS];
+    TMP117SampleTime time_;
+    uint8_t   sensor_;
+
+    void      merge(uint8_t level, const TMP117_bucket &b);
+    void      close(uint8_t level);
+};
+#endif
@@ -0,0 +1,67 @@
+/*!
+ * @brief   Adaptive sampling interval for TMP117 'Lite'
+ *
+ * @license MIT License (see license.txt)
+ *
+ * The sampling interval follows the rate of change of the temperature: the interval is chosen such that the
+ * temperature is expected to change no more than the error budget between two samples.
+ * - fast changes shorten the interval immediately; a change beyond twice the budget restarts at the minimum interval
+ * - stable readings stretch the interval by at most a factor 2 per sample (up to the maximum interval)
+ * Integer arithmetic only.
+ *
+ * A rate-driven interval cannot anticipate a change: after a stable period, an onset is seen up to one maximum
+ * interval late. Paired with the window alert mode (half window: window()), the sensor wakes the MCU as soon as the
+ * temperature leaves the window; that reading exceeds twice the budget and restarts at the minimum interval.
+ */
+
+#include "TMP117Sampler.h"
+
+/**
+ * @brief Constructor - setup interval bounds and error budget
+ *
+ * @param minInterval Shortest sampling interval [ms]
+ * @param maxInterval Longest sampling interval [ms]
+ * @param budget Allowed temperature change between two samples in 0.0078125°C per increment (>0)
+ */
+TMP117Sampler::TMP117Sampler(uint32_t minInterval, uint32_t maxInterval, uint16_t budget)
+  : minInterval_(minInterval), maxInterval_(maxInterval), budget_(budget ? budget : 1) {
+  reset();
+}
+
+/**
+ * @brief Restart at the shortest interval (e.g. after sensor reset or missing data)
+ */
+void TMP117Sampler::reset(void) {
+  interval_ = minInterval_;
+  valid_ = false;
+}
+
+/**
+ * @brief Feed a new sample, compute the next sampling interval
+ *
+ * @param temp Most recent temperature
+ * @param now Sample time [ms]
+ * @returns Next sampling interval [ms]
+ */
+uint32_t TMP117Sampler::update(int16_t temp, uint32_t now) {
+  if (valid_) {
+    uint32_t dt = now - lastTime_;
+    uint32_t dT = temp > lastTemp_ ? temp - lastTemp_ : lastTemp_ - temp;
+    uint32_t next = 2 * interval_; // stable: stretch
+
+    // interval at which the observed rate of change uses up the error budget: budget * dt / dT
+    if (dT > 2 * (uint32_t)budget_) // budget exceeded: the rate averaged over dt underestimates the actual rate
+      next = minInterval_;
+    else if (dT != 0) {
+      uint64_t target = (uint64_t)budget_ * dt / dT;
+      if (target < next)
+        next = target;
+    }
+    interval_ = next < minInterval_ ? minInterval_ : next > maxInterval_ ? maxInterval_ : next;
+  }
+
+  lastTime_ = now;
+  lastTemp_ = temp;
+  valid_ = true;
+  return interval_;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file TMP117Sampler.h
+ */
+#ifndef _TMP117_SAMPLER_H_
+#define _TMP117_SAMPLER_H_
+
+#include <stdint.h>
+
+class TMP117Sampler {
+
+  public:
+              TMP117Sampler(uint32_t min_interval, uint32_t max_interval, uint16_t error_budget);
+
+    uint32_t  update(int16_t temp, uint32_t now);
+    uint32_t  interval(void) const { return interval_; }
+    uint16_t  window(void) const { return 2 * budget_; } // half window for the window alert mode [raw counts]
+    void      reset(void);
+
+  private:
+    const uint32_t minInterval_;
+    const uint32_t maxInterval_;
+    const uint16_t budget_;
+    uint32_t  interval_;
+    uint32_t  lastTime_;
+    int16_t   lastTemp_;
+    bool      valid_;
+};
+#endif
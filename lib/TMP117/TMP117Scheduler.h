@@ -0,0 +1,184 @@
+/**
+ * @file TMP117Scheduler.h
+ *
+ * @brief Earliest-deadline-first scheduler for TMP117 sensors with individual sample rates
+ *
+ * Each sensor has its own period and (relative) deadline, counted from its release time. At each wake-up all
+ * conversions released within the wake window are started in earliest-deadline order, so sensors with nearby
+ * release times share one wake-up. Conversion starts and sensor reads are issued one at a time from task context
+ * (shared bus), both in earliest-deadline order. Sensors use deferred Data Ready handling (dispatch table or
+ * dataReady() in the ISR); a deadline is met when the Data Ready event is on time, however late run() reads it.
+ */
+#ifndef _TMP117_SCHEDULER_H_
+#define _TMP117_SCHEDULER_H_
+
+#include "TMP117.h"
+#include "TMP117Completion.h"
+
+template <uint8_t N>
+class TMP117Scheduler {
+
+  public:
+              TMP117Scheduler(uint32_t window) : window_(window), count_(0), busy_(0), started_(false) {}
+
+    /**
+     * @brief Add sensor to schedule
+     *
+     * @param sensor Initialized sensor
+     * @param period Sampling period [ms]
+     * @param deadline Data must be read within deadline after release [ms] (conversion time <= deadline <= period)
+     * @param now Actual time, first release [ms]
+     * @returns Error flag when table full or deadline infeasible
+     */
+    bool add(TMP117 &sensor, uint32_t period, uint32_t deadline, uint32_t now) {
+      if (count_ >= N || deadline < sensor.conversionTime() || deadline > period)
+        return true;
+
+      job_t &j = jobs_[count_++];
+      j.sensor = &sensor;
+      j.period = period;
+      j.deadline = deadline;
+      j.release = now;
+      j.due = 0;
+      j.active = false;
+      j.missed = 0;
+      return false;
+    }
+
+    /**
+     * @brief Read completed conversions and start released conversions (call at each wake-up)
+     *
+     * @param now Actual time [ms]
+     * @returns Time of next required wake-up [ms]
+     */
+    uint32_t run(uint32_t now) {
+      return schedule(now, nullptr);
+    }
+
+    /**
+     * @brief Read completed conversions and start released conversions (call at each wake-up)
+     *
+     * @param now Actual time [ms]
+     * @param sensorsServiced Completion set - marks the sensors read by this run()
+     * @returns Time of next required wake-up [ms]
+     */
+    uint32_t run(uint32_t now, TMP117Completion &sensorsServiced) {
+      return schedule(now, &sensorsServiced);
+    }
+
+    /**
+     * @param slot Sensor index, in order of add()
+     * @returns Number of missed deadlines for this sensor
+     */
+    uint16_t missed(uint8_t slot) const { return slot < count_ ? jobs_[slot].missed : 0; }
+
+    /**
+     * @returns Requested utilization: sum of conversion time / period [‰]
+     */
+    uint16_t demand(void) const {
+      uint32_t u = 0;
+      for (uint8_t i = 0; i < count_; i++)
+        u += (uint32_t)jobs_[i].sensor->conversionTime() * 1000 / jobs_[i].period;
+      return u;
+    }
+
+    /**
+     * @param now Actual time [ms]
+     * @returns Achieved utilization: conversion time of completed conversions / elapsed time [‰]
+     */
+    uint16_t utilization(uint32_t now) const {
+      uint32_t elapsed = now - start_;
+      return started_ && elapsed ? (uint64_t)busy_ * 1000 / elapsed : 0;
+    }
+
+  private:
+    typedef struct {
+      TMP117 *  sensor;
+      uint32_t  period;
+      uint32_t  deadline;
+      uint32_t  release;                  // next release time
+      uint32_t  due;                      // absolute deadline of active conversion
+      bool      active;
+      uint16_t  missed;
+    } job_t;
+
+    const uint32_t window_;
+    job_t     jobs_[N];
+    uint8_t   count_;
+    uint32_t  busy_;
+    uint32_t  start_;
+    bool      started_;
+
+    // read completions, abandon late conversions, start released conversions; returns next wake-up [ms]
+    uint32_t schedule(uint32_t now, TMP117Completion * const sensorsServiced) {
+      if (!started_) {
+        start_ = now;
+        started_ = true;
+      }
+
+      // read completed conversions in EDF order, judged by their Data Ready time
+      while (true) {
+        job_t *next = nullptr;
+        for (uint8_t i = 0; i < count_; i++) {
+          job_t &j = jobs_[i];
+          if (j.active && j.sensor->pending() && (next == nullptr || (int32_t)(j.due - next->due) < 0))
+            next = &j;
+        }
+        if (next == nullptr)
+          break;
+
+        uint32_t ready = now - (micros() - next->sensor->readyTime()) / 1000; // Data Ready [ms]
+        uint32_t serviced = 0;
+        next->sensor->service(&serviced);
+        if (sensorsServiced != nullptr)
+          sensorsServiced->set(next->sensor->sensorId());
+        next->active = false;
+        if ((int32_t)(ready - next->due) > 0)
+          next->missed++;
+        else
+          busy_ += next->sensor->conversionTime();
+      }
+
+      // abandon conversions past their deadline
+      for (uint8_t i = 0; i < count_; i++) {
+        job_t &j = jobs_[i];
+        if (j.active && (int32_t)(now - j.due) > 0) {
+          j.active = false;
+          j.missed++;
+        }
+      }
+
+      // start released conversions in EDF order, including those released within the wake window
+      while (true) {
+        job_t *next = nullptr;
+        for (uint8_t i = 0; i < count_; i++) {
+          job_t &j = jobs_[i];
+          if (!j.active && (int32_t)(j.release - (now + window_)) <= 0)
+            if (next == nullptr || (int32_t)(j.release + j.deadline - (next->release + next->deadline)) < 0)
+              next = &j;
+        }
+        if (next == nullptr)
+          break;
+
+        next->due = next->release + next->deadline;
+        next->release += next->period;
+        if ((int32_t)(next->due - now) < (int32_t)next->sensor->conversionTime()) { // too late, skip this release
+          next->missed++;
+          continue;
+        }
+        next->active = true;
+        next->sensor->startConversion();
+      }
+
+      // next wake-up: first release or first deadline of an active conversion
+      uint32_t wakeup = now + UINT32_MAX / 2;
+      for (uint8_t i = 0; i < count_; i++) {
+        const job_t &j = jobs_[i];
+        uint32_t t = j.active ? j.due : j.release - window_;
+        if ((int32_t)(t - wakeup) < 0)
+          wakeup = t;
+      }
+      return wakeup;
+    }
+};
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file TMP117Settle.h
+ *
+ * @brief Settled temperature prediction: extrapolates a first-order (exponential) thermal response to its asymptote
+ *
+ * The last 3K equally spaced samples of T(t) = T∞ + c·e^(-t/τ) form three blocks of K samples with sums S1, S2, S3
+ * (kept as running sums, O(1) per sample). Each sum is K·T∞ plus a term decaying by ρ = e^(-KΔt/τ) per block, so the
+ * differences a = S2 - S1 and b = S3 - S2 have the ratio ρ = b/a, and T∞ = (S3 + b²/(a - b)) / K (Aitken
+ * extrapolation). Using block sums instead of three single samples reduces the noise of the prediction by √K. The
+ * prediction is only used while the response is converging (a, b same sign, ρ below a limit that bounds the
+ * extrapolation to ρ/(1-ρ) times b) and the step is above the noise level; otherwise the latest sample is returned.
+ */
+#ifndef _TMP117_SETTLE_H_
+#define _TMP117_SETTLE_H_
+
+#include "TMP117.h"
+
+template <uint8_t K>
+class TMP117Settle : public TMP117Sink {
+    static_assert(K >= 1, "block size must be at least 1");
+
+  public:
+    /**
+     * @param noise Minimum step between block means [raw counts] to extrapolate, e.g. 8 (62.5m°C)
+     * @param maxRatio Maximum ρ [‰]; 900 limits the extrapolation to 9·b
+     */
+              TMP117Settle(uint16_t noise = 8, uint16_t maxRatio = 900) : noise_(noise), maxRatio_(maxRatio) { reset(); }
+
+    /**
+     * @brief Add sample from the sensor stream (sample timestamps in µs are extended to a ms time base)
+     */
+    void onSample(const TMP117_sample &s) {
+      add(s.temp.raw(), time_.update(s.timestamp));
+    }
+
+    void reset(void) {
+      count_ = pos_ = 0;
+      sum_[0] = sum_[1] = sum_[2] = 0;
+      ratio_ = 0;
+      extrapolated_ = false;
+    }
+
+    /**
+     * @brief Add sample; samples are expected at a fixed interval, the prediction is suspended when they are not
+     *
+     * @param raw Temperature in 0.0078125°C per increment
+     * @param now Sample time [ms]
+     */
+    void add(int16_t raw, uint32_t now) {
+      if (count_ < SIZE)
+        sum_[count_++ / K] += raw;
+      else { // slide the blocks: the first sample of each block moves to the previous one, the oldest leaves
+        uint16_t i2 = at(K), i3 = at(2 * K);
+        sum_[0] += y_[i2] - y_[pos_];
+        sum_[1] += y_[i3] - y_[i2];
+        sum_[2] += raw - y_[i3];
+      }
+      y_[pos_] = raw;
+      t_[pos_] = now;
+      pos_ = pos_ + 1 < SIZE ? pos_ + 1 : 0;
+      predicted_ = raw;
+      extrapolated_ = false;
+      ratio_ = 0;
+      if (count_ < SIZE)
+        return;
+
+      // pos_ is now the oldest sample: block starts at pos_, i2, i3
+      uint16_t i2 = at(K), i3 = at(2 * K);
+      uint32_t d1 = t_[i2] - t_[pos_], d2 = t_[i3] - t_[i2], d3 = (now - t_[i3]) * K;
+      if ((d1 > d2 ? d1 - d2 : d2 - d1) > (d1 + d2) / 16 || // spacing differs more than ~12%
+          (d3 > d2 * (K - 1) ? d3 - d2 * (K - 1) : d2 * (K - 1) - d3) > d2 * K / 8)
+        return;
+
+      int32_t a = sum_[1] - sum_[0];
+      int32_t b = sum_[2] - sum_[1];
+      int8_t sign = 1;
+      if (a < 0) { // mirror a falling response
+        sign = -1;
+        a = -a;
+        b = -b;
+      }
+      if (a < (int32_t)noise_ * K || b < 0 || b >= a)
+        return;
+      ratio_ = (uint64_t)b * 1000 / a;
+      if (ratio_ > maxRatio_)
+        return;
+      int64_t t = sum_[2] + sign * ((int64_t)b * b / (a - b)); // K·T∞
+      t = (t + (t < 0 ? -(K / 2) : K / 2)) / K;
+      predicted_ = t > INT16_MAX ? INT16_MAX : t < INT16_MIN ? INT16_MIN : t;
+      extrapolated_ = true;
+    }
+
+    /**
+     * @returns Predicted settled temperature, or the latest sample when not extrapolating
+     */
+    TMP117_temp predicted(void) const { return TMP117_temp(predicted_); }
+
+    /**
+     * @returns true if predicted() is extrapolated from a converging response
+     */
+    bool      extrapolated(void) const { return extrapolated_; }
+
+    /**
+     * @returns ρ [‰] of the last converging response (0 if none); τ = -KΔt / ln(ρ)
+     */
+    uint16_t  ratio(void) const { return ratio_; }
+
+  private:
+    static const uint16_t SIZE = 3 * K;
+    const uint16_t noise_;
+    const uint16_t maxRatio_;
+    TMP117SampleTime time_;
+    int16_t   y_[SIZE];
+    uint32_t  t_[SIZE];
+    int32_t   sum_[3];                    // block sums, oldest first
+    uint16_t  count_;
+    uint16_t  pos_;                       // oldest sample
+    int16_t   predicted_;
+    uint16_t  ratio_;
+    bool      extrapolated_;
+
+    uint16_t  at(uint16_t i) const { return pos_ + i < SIZE ? pos_ + i : pos_ + i - SIZE; }
+};
+#endif
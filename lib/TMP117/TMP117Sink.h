@@ -0,0 +1,55 @@
+/**
+ * @file TMP117Sink.h
+ *
+ * @brief Sample stream: sources (sensors, filters) pass each new sample to their attached sinks
+ *
+ * Sinks are called from the context reading the sensor (the ISR when readSensor() is called from the ISR, task
+ * context when using service()).
+ */
+#ifndef _TMP117_SINK_H_
+#define _TMP117_SINK_H_
+
+#include <stdint.h>
+
+typedef struct TMP117_sample TMP117_sample;
+
+class TMP117Sink {
+
+  public:
+    virtual void onSample(const TMP117_sample &sample) = 0;
+
+  protected:
+              TMP117Sink() : next_(nullptr) {}
+
+  private:
+    friend class TMP117Source;
+    TMP117Sink * next_;
+};
+
+class TMP117Source {
+
+  public:
+    /**
+     * @brief Attach sink, it receives all subsequent samples (a sink can be attached to one source only)
+     *
+     * @param sink Sample consumer
+     */
+    void attach(TMP117Sink &sink) {
+      TMP117Sink **p = &sinks_;
+      while (*p != nullptr)
+        p = &(*p)->next_;
+      *p = &sink;
+    }
+
+  protected:
+              TMP117Source() : sinks_(nullptr) {}
+
+    void emit(const TMP117_sample &sample) {
+      for (TMP117Sink *s = sinks_; s != nullptr; s = s->next_)
+        s->onSample(sample);
+    }
+
+  private:
+    TMP117Sink * sinks_;
+};
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file TMP117Stats.h
+ *
+ * @brief Running statistics (Welford) of raw TMP117 temperatures, integer only
+ *
+ * O(1) per sample: count, mean (Q12 raw counts) and sum of squared deviations (Q24 raw counts²).
+ * Partial results can be merged (Chan et al.), e.g. to combine reporting intervals or sensors.
+ */
+#ifndef _TMP117_STATS_H_
+#define _TMP117_STATS_H_
+
+#include <stdint.h>
+#include "TMP117Temperature.h"
+
+class TMP117Stats {
+
+  public:
+              TMP117Stats() { reset(); }
+
+    void      reset(void) { n_ = 0; mean_ = 0; m2_ = 0; }
+
+    /**
+     * @brief Add sample
+     *
+     * @param raw Temperature in 0.0078125°C per increment
+     */
+    void add(int16_t raw) {
+      int32_t x = (int32_t)raw * 4096;
+      int32_t delta = x - mean_;
+      n_++;
+      mean_ += div(delta, n_);
+      m2_ += (uint64_t)((int64_t)delta * (x - mean_)); // delta and (x - mean) have the same sign
+    }
+
+    /**
+     * @brief Merge statistics of another interval or sensor
+     *
+     * @param s Statistics to merge
+     */
+    void merge(const TMP117Stats &s) {
+      if (s.n_ == 0)
+        return;
+      if (n_ == 0) {
+        *this = s;
+        return;
+      }
+
+      uint32_t n = n_ + s.n_;
+      int64_t delta = (int64_t)s.mean_ - mean_;
+      uint64_t d2 = (uint64_t)(delta * delta);
+      mean_ += (int32_t)(delta * s.n_ / (int64_t)n);
+      m2_ += s.m2_ + (d2 < (1ull << 32) ? d2 * n_ / n * s.n_ : d2 / n * n_ * s.n_);
+      n_ = n;
+    }
+
+    uint32_t  count(void) const { return n_; }
+    int32_t   mean(void) const { return div(mean_, 16); }                // Q8, 1/32768°C per increment
+    TMP117_temp meanTemp(void) const { return TMP117_temp(div(mean_, 4096)); }
+
+    /**
+     * @returns Sample variance in raw counts² (Q8), saturated
+     */
+    uint32_t variance(void) const {
+      if (n_ < 2)
+        return 0;
+      uint64_t v = m2_ / (n_ - 1) / 65536;
+      return v > UINT32_MAX ? UINT32_MAX : v;
+    }
+
+  private:
+    uint32_t  n_;
+    int32_t   mean_;                      // Q12
+    uint64_t  m2_;                        // Q24
+
+    static int32_t div(int32_t n, int32_t d) { return (n < 0 ? n - d / 2 : n + d / 2) / d; } // rounded
+};
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file TMP117TempHistogram.h
+ *
+ * @brief Fixed-bin temperature histogram (time spent per temperature band), O(1) per sample
+ *
+ * N bins of any whole number of raw counts (7.8125m°C each) starting at origin, plus underflow and overflow bins.
+ * Counters are 32-bit (a month at one sample per second fits), saturating at 2^32 - 1.
+ *
+ * Compact export format (little endian):
+ *   [N] [width lo] [width hi] [origin lo] [origin hi] [underflow] [bin 0] ... [bin N-1] [overflow]
+ * with each count as unsigned LEB128 varint (1 byte for counts < 128, max. 5 bytes).
+ */
+#ifndef _TMP117_TEMP_HISTOGRAM_H_
+#define _TMP117_TEMP_HISTOGRAM_H_
+
+#include <stddef.h>
+#include "TMP117.h"
+
+template <uint8_t N>
+class TMP117TempHistogram : public TMP117Sink {
+
+  public:
+    /**
+     * @param origin Lower edge of bin 0
+     * @param width Bin width, whole raw counts (at least 1), e.g. TMP117_temp::fromMilli(500): 64 counts, 0.5°C
+     */
+              TMP117TempHistogram(TMP117_temp origin, TMP117_temp width)
+                : origin_(origin.raw()), width_(width.raw() > 0 ? width.raw() : 1) { clear(); }
+
+    void      onSample(const TMP117_sample &sample) { add(sample.temp.raw()); }
+
+    void add(int16_t raw) {
+      int32_t d = (int32_t)raw - origin_;
+      uint32_t i = d < 0 ? 0 : (uint32_t)d / width_;
+      uint32_t &c = d < 0 ? bin_[0] : i >= N ? bin_[N + 1] : bin_[i + 1];
+      if (c != UINT32_MAX)
+        c++;
+    }
+
+    void clear(void) {
+      for (uint16_t i = 0; i < N + 2; i++)
+        bin_[i] = 0;
+    }
+
+    uint32_t  count(uint8_t bin) const { return bin < N ? bin_[bin + 1] : 0; }
+    uint32_t  underflow(void) const { return bin_[0]; }
+    uint32_t  overflow(void) const { return bin_[N + 1]; }
+
+    /**
+     * @param bin Bin [0-N], N: upper edge of the last bin
+     * @returns Lower edge of the bin, limited to the temperature range (+255.99°C)
+     */
+    TMP117_temp lowerEdge(uint16_t bin) const {
+      int32_t edge = origin_ + (int32_t)bin * width_;
+      return TMP117_temp(edge > INT16_MAX ? INT16_MAX : edge);
+    }
+
+    /**
+     * @brief Quantile of the counted samples (nearest rank), exact to half a bin width whatever the sample order
+     *
+     * @param permille Quantile [1-999‰], e.g. 950 for P95
+     * @returns Middle of the bin holding the quantile, origin (underflow) or upper edge of the bins (overflow),
+     *          0 when empty
+     */
+    TMP117_temp quantile(uint16_t permille) const {
+      uint64_t total = 0, sum = 0;
+      for (uint16_t i = 0; i < N + 2; i++)
+        total += bin_[i];
+      if (total == 0)
+        return TMP117_temp();
+
+      uint64_t rank = (total * permille + 999) / 1000;
+      uint16_t i = 0;
+      while ((sum += bin_[i]) < rank)
+        i++;
+      if (i == 0)
+        return lowerEdge(0);
+      if (i == N + 1)
+        return lowerEdge(N);
+      return lowerEdge(i - 1) + TMP117_temp(width_ / 2);
+    }
+
+    /**
+     * @brief Compact export
+     *
+     * @param buffer Output buffer, max. 5 + 5 * (N + 2) bytes
+     * @param size Buffer size
+     * @returns # bytes written, 0 when the buffer is too small
+     */
+    size_t serialize(uint8_t * const buffer, size_t size) const {
+      size_t len = 0;
+      if (size < 5)
+        return 0;
+      buffer[len++] = N;
+      buffer[len++] = width_ & 0xFF;
+      buffer[len++] = width_ >> 8;
+      buffer[len++] = (uint16_t)origin_ & 0xFF;
+      buffer[len++] = (uint16_t)origin_ >> 8;
+
+      for (uint16_t i = 0; i < N + 2; i++) {
+        uint32_t c = bin_[i];
+        do {
+          if (len >= size)
+            return 0;
+          buffer[len++] = (c & 0x7F) | (c > 0x7F ? 0x80 : 0);
+          c >>= 7;
+        } while (c);
+      }
+      return len;
+    }
+
+  private:
+    const int16_t origin_;
+    const uint16_t width_;                // [raw counts]
+    uint32_t  bin_[N + 2];                // underflow, bins, overflow
+};
+#endif
@@ -0,0 +1,52 @@
+/**
+ * @file TMP117Temperature.h
+ *
+ * @brief Fixed-point temperature value, 0.0078125°C (1/128°C) per increment - the TMP117 register format
+ *
+ * Integer only: conversions are exactly rounded (half away from zero), arithmetic saturates at the ±256°C range.
+ */
+#ifndef _TMP117_TEMPERATURE_H_
+#define _TMP117_TEMPERATURE_H_
+
+#include <stdint.h>
+
+class TMP117_temp {
+
+  public:
+    constexpr TMP117_temp() : raw_(0) {}
+    explicit constexpr TMP117_temp(int16_t raw) : raw_(raw) {}
+
+    static constexpr TMP117_temp fromMilli(int32_t mdeg) { return TMP117_temp(sat(div(mdeg * 16, 125))); }
+    static constexpr TMP117_temp fromCenti(int32_t cdeg) { return TMP117_temp(sat(div(cdeg * 32, 25))); }
+    static constexpr TMP117_temp fromDegrees(int16_t deg) { return TMP117_temp(sat((int32_t)deg * 128)); }
+
+    constexpr int16_t raw(void) const { return raw_; }
+    constexpr int32_t milli(void) const { return div((int32_t)raw_ * 125, 16); }   // m°C
+    constexpr int32_t centi(void) const { return div((int32_t)raw_ * 25, 32); }    // c°C
+    constexpr int16_t degrees(void) const { return div(raw_, 128); }               // °C
+
+    // Q-format with F fractional bits (Q7 = raw)
+    template <uint8_t F> constexpr int32_t q(void) const {
+      return F >= 7 ? (int32_t)raw_ * (1l << (F >= 7 ? F - 7 : 0)) : div(raw_, 1l << (F < 7 ? 7 - F : 0));
+    }
+
+    friend constexpr TMP117_temp operator+(TMP117_temp a, TMP117_temp b) { return TMP117_temp(sat((int32_t)a.raw_ + b.raw_)); }
+    friend constexpr TMP117_temp operator-(TMP117_temp a, TMP117_temp b) { return TMP117_temp(sat((int32_t)a.raw_ - b.raw_)); }
+    friend constexpr TMP117_temp operator-(TMP117_temp a) { return TMP117_temp(sat(-(int32_t)a.raw_)); }
+    friend constexpr bool operator==(TMP117_temp a, TMP117_temp b) { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(TMP117_temp a, TMP117_temp b) { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(TMP117_temp a, TMP117_temp b) { return a.raw_ < b.raw_; }
+    friend constexpr bool operator<=(TMP117_temp a, TMP117_temp b) { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>(TMP117_temp a, TMP117_temp b) { return a.raw_ > b.raw_; }
+    friend constexpr bool operator>=(TMP117_temp a, TMP117_temp b) { return a.raw_ >= b.raw_; }
+
+  private:
+    int16_t   raw_;
+
+    static constexpr int16_t sat(int32_t v) { return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : v; }
+    static constexpr int32_t div(int32_t n, int32_t d) { return (n < 0 ? n - d / 2 : n + d / 2) / d; } // rounded
+};
+
+static_assert(TMP117_temp(-1).milli() == -8 && TMP117_temp(3).milli() == 23, "rounding");
+static_assert(TMP117_temp::fromCenti(2500).raw() == 3200 && TMP117_temp::fromMilli(-7).raw() == -1, "rounding");
+#endif
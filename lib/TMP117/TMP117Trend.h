@@ -0,0 +1,140 @@
+/**
+ * @file TMP117Trend.h
+ *
+ * @brief Rate of change (dT/dt) by least-squares fit over the last N samples, O(1) per sample, integer only
+ *
+ * Running sums of x (time), y (temperature), x², xy and y² are updated as samples enter and leave the window.
+ * Time is counted in units of unit_ms relative to an epoch, which is moved (re-summing the window) when x reaches
+ * 2^20 units - the window span must stay well below 2^20 units (e.g. unit 1s: 12 days).
+ */
+#ifndef _TMP117_TREND_H_
+#define _TMP117_TREND_H_
+
+#include "TMP117.h"
+
+template <uint8_t N>
+class TMP117Trend : public TMP117Sink {
+
+  public:
+    /**
+     * @param unit Time unit [ms], e.g. 1000 when samples are seconds or more apart
+     */
+              TMP117Trend(uint32_t unit = 1000) : unit_(unit ? unit : 1) { reset(); }
+
+    /**
+     * @brief Add sample from the sensor stream (sample timestamps in µs are extended to a ms time base)
+     */
+    void onSample(const TMP117_sample &s) {
+      add(s.temp.raw(), time_.update(s.timestamp));
+    }
+
+    void reset(void) {
+      count_ = pos_ = 0;
+      sx_ = sy_ = sxx_ = sxy_ = syy_ = 0;
+      started_ = false;
+    }
+
+    /**
+     * @brief Add sample
+     *
+     * @param raw Temperature in 0.0078125°C per increment
+     * @param now Sample time [ms]
+     */
+    void add(int16_t raw, uint32_t now) {
+      if (!started_) {
+        epoch_ = now;
+        started_ = true;
+      }
+      uint32_t x = (now - epoch_) / unit_;
+      if (x >= (1ul << 20)) { // move epoch to the oldest sample
+        uint32_t shift = count_ ? x_[count_ < N ? 0 : pos_] : x;
+        epoch_ += shift * unit_;
+        x -= shift;
+        sx_ = sy_ = sxx_ = sxy_ = syy_ = 0;
+        for (uint8_t i = 0; i < count_; i++) {
+          x_[i] -= shift;
+          sum(x_[i], y_[i], 1);
+        }
+      }
+
+      if (count_ == N)
+        sum(x_[pos_], y_[pos_], -1);
+      else
+        count_++;
+      x_[pos_] = x;
+      y_[pos_] = raw;
+      sum(x, raw, 1);
+      pos_ = pos_ + 1 < N ? pos_ + 1 : 0;
+    }
+
+    uint8_t   count(void) const { return count_; }
+
+    /**
+     * @returns Slope in raw counts per time unit, Q16 (0 when less than 2 samples or no time spread)
+     */
+    int32_t slope(void) const {
+      int64_t vx = varX();
+      return vx > 0 ? ratio(cov(), vx, 16) : 0;
+    }
+
+    /**
+     * @returns Rate of change [m°C/minute]
+     */
+    int32_t rate(void) const {
+      int64_t vx = varX(), c = cov();
+      if (vx <= 0)
+        return 0;
+      while ((c > 0 ? c : -c) >= (1ll << 43) && vx > 1) { // c * 468750 < 2^62
+        c /= 2;
+        vx /= 2;
+      }
+      // counts/unit -> m°C/min: * 1000/128 * 60000/unit, not via the Q16 slope (too coarse for small units)
+      int64_t r = c * 468750 / vx / unit_;
+      return r > INT32_MAX ? INT32_MAX : r < INT32_MIN ? INT32_MIN : r;
+    }
+
+    /**
+     * @returns Confidence: coefficient of determination R² [‰] (1000: all samples on a straight line)
+     */
+    uint16_t confidence(void) const {
+      int64_t vx = varX(), vy = varY(), c = cov();
+      if (vx <= 0 || vy <= 0)
+        return 0;
+      int64_t r2 = (int64_t)ratio(c, vx, 16) * ratio(c, vy, 16); // Q32
+      return r2 <= 0 ? 0 : r2 >= (1ll << 32) ? 1000 : (r2 * 1000) >> 32;
+    }
+
+  private:
+    const uint32_t unit_;
+    TMP117SampleTime time_;
+    uint32_t  epoch_;
+    bool      started_;
+    uint32_t  x_[N];
+    int16_t   y_[N];
+    uint8_t   count_;
+    uint8_t   pos_;
+    int64_t   sx_, sy_, sxx_, sxy_, syy_;
+
+    void sum(int64_t x, int64_t y, int8_t sign) {
+      sx_ += sign * x;
+      sy_ += sign * y;
+      sxx_ += sign * x * x;
+      sxy_ += sign * x * y;
+      syy_ += sign * y * y;
+    }
+
+    int64_t   cov(void) const { return count_ * sxy_ - sx_ * sy_; }
+    int64_t   varX(void) const { return count_ * sxx_ - sx_ * sx_; }
+    int64_t   varY(void) const { return count_ * syy_ - sy_ * sy_; }
+
+    // (num << frac) / den, reducing precision instead of overflowing, saturated to int32
+    static int32_t ratio(int64_t num, int64_t den, uint8_t frac) {
+      while ((num > 0 ? num : -num) >= (1ll << (62 - frac)) && den > 1) {
+        num /= 2;
+        den /= 2;
+      }
+      int64_t r = num * (1ll << frac) / den;
+      return r > INT32_MAX ? INT32_MAX : r < INT32_MIN ? INT32_MIN : r;
+    }
+};
+#endif
@@ -0,0 +1,120 @@
+/**
+ * @file TMP117Window.h
+ *
+ * @brief Rolling (sliding-window) min/max temperature, amortized O(1) per sample in fixed memory for any window
+ *
+ * The window is divided into N blocks (window / N each). Each block's min/max is accumulated as samples arrive;
+ * completed blocks enter monotonic deques that only keep blocks which can still hold the window's minimum
+ * (maximum). The result covers the current block and the N blocks before it: at least the window, and at most
+ * one block more - no extreme inside the window is ever dropped, whatever the sample rate.
+ */
+#ifndef _TMP117_WINDOW_H_
+#define _TMP117_WINDOW_H_
+
+#include "TMP117.h"
+
+template <uint16_t N>
+class TMP117Window : public TMP117Sink {
+
+  public:
+    /**
+     * @param window Window length [ms], e.g. 3600000ul for 1 hour (resolution window / N)
+     */
+              TMP117Window(uint32_t window) : block_(window / N ? window / N : 1), started_(false), start_(0), current_(0),
+                                       min_(0), max_(0) {}
+
+    /**
+     * @brief Add sample from the sensor stream (sample timestamps in µs are extended to a ms time base)
+     */
+    void onSample(const TMP117_sample &s) {
+      add(s.temp.raw(), time_.update(s.timestamp));
+    }
+
+    /**
+     * @brief Add sample
+     *
+     * @param raw Temperature in 0.0078125°C per increment
+     * @param now Sample time [ms]
+     */
+    void add(int16_t raw, uint32_t now) {
+      if (!started_) {
+        start_ = now;
+        current_ = 0;
+        min_ = max_ = raw;
+        started_ = true;
+        return;
+      }
+
+      uint32_t blocks = (now - start_) / block_;
+      if (blocks) { // close current block
+        minQ_.push(min_, current_, false);
+        maxQ_.push(max_, current_, true);
+        current_ += blocks;
+        start_ += blocks * block_;
+        minQ_.expire(current_ - N);
+        maxQ_.expire(current_ - N);
+        min_ = max_ = raw;
+      }
+      else {
+        if (raw < min_) min_ = raw;
+        if (raw > max_) max_ = raw;
+      }
+    }
+
+    bool      valid(void) const { return started_; }
+    TMP117_temp min(void) const { return TMP117_temp(minQ_.empty() || min_ < minQ_.front() ? min_ : minQ_.front()); }
+    TMP117_temp max(void) const { return TMP117_temp(maxQ_.empty() || max_ > maxQ_.front() ? max_ : maxQ_.front()); }
+
+  private:
+    // monotonic deque of completed blocks, at most N blocks are in range
+    class deque_t {
+
+      public:
+                  deque_t() : head_(0), size_(0) {}
+
+        void push(int16_t raw, uint32_t block, bool keepMax) {
+          while (size_ && (keepMax ? at(size_ - 1).raw <= raw : at(size_ - 1).raw >= raw))
+            size_--;
+          if (size_ == N) { // not reached: blocks out of range are expired first
+            head_ = head_ + 1 < N ? head_ + 1 : 0;
+            size_--;
+          }
+          entry_t &e = at(size_++);
+          e.raw = raw;
+          e.block = block;
+        }
+
+        void expire(uint32_t oldest) {
+          while (size_ && (int32_t)(at(0).block - oldest) < 0) {
+            head_ = head_ + 1 < N ? head_ + 1 : 0;
+            size_--;
+          }
+        }
+
+        bool      empty(void) const { return size_ == 0; }
+        int16_t   front(void) const { return entry_[head_].raw; }
+
+      private:
+        typedef struct {
+          uint32_t  block;
+          int16_t   raw;
+        } entry_t;
+
+        entry_t   entry_[N];
+        uint16_t  head_;
+        uint16_t  size_;
+
+        entry_t & at(uint16_t i) { return entry_[head_ + i < N ? head_ + i : head_ + i - N]; }
+    };
+
+    const uint32_t block_;                // block length [ms]
+    TMP117SampleTime time_;
+    bool      started_;
+    uint32_t  start_;                     // start of the current block [ms]
+    uint32_t  current_;                   // current block #
+    int16_t   min_;                       // current block
+    int16_t   max_;
+    deque_t   minQ_;
+    deque_t   maxQ_;
+};
+#endif
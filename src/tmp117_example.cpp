@@ -17,17 +17,30 @@
 #include <Arduino.h>
 #include "tmp117_example.h"
 #include "TMP117.h"
+#include "TMP117Sampler.h"
+#include "TMP117Ring.h"
+#include "TMP117Barrier.h"
+#include "TMP117EventLoop.h"
+#include "TMP117Format.h"
 
 static uint8_t sensorCount = 0;           // keep track of available sensors
-static uint32_t sensorsServiced;          // sensor n sets bit[n] when serviced after issuing sensor ready interrupt
+static TMP117Barrier<1> sweep(75);        // per-sensor deadline: conversion time (125ms in this example) + 75ms
 static int16_t temperature;
-static uint32_t startTime;
+static TMP117Ring<16> samples;            // sensor samples waiting to be processed, pushed by the read path
+
+TMP117RtcClock Clock;                     // standby until the next timer (RTC alarm) or interrupt; millis() stops in standby,
+                                          // and so does SerialUSB: use TMP117ArduinoClock while debugging over USB
+TMP117EventLoop Events(Clock);
+
+TMP117Sampler Sampler(10 * 1000,         // sample at least every 15 minutes, at most every 10 seconds
+                      15 * 60 * 1000,
+                      13                  // allow ~0.1°C (13 * 7.8125m°C) change between samples
+                      );
 
 TMP117 TempSensor(ADD0_TO_VCC,            // default Bluedot configuration
                   TMP117_ALERT,           // interrupt wiring: TMP117-Alert -> SAMD21G-PA11/MUX_PA11B_ADC_AIN19
-                  TempSensorReady,        // callback to handle sensor ready interrupt
                   Error                   // callback (optional)
-                  );
+                  );                      // sensor ready interrupt is dispatched by the driver
 
 void setup() {
   SerialUSB.begin(115200);
@@ -52,14 +65,17 @@ void setup() {
   }
   else
     TempSensor.init(0, sensorCount++); // typical use after TMP117 POR is programmed
-  
+  sweep.add(TempSensor);
+  TempSensor.attach(samples);
+  Clock.begin(); // after the sensors' init(): Alert edges wake up from standby
+
   // read lowest/highest temperatures stored in the sensor's EEPROM
-  int16_t tempMin = TempSensor.getTemperature(T_MIN);
-  int16_t tempMax = TempSensor.getTemperature(T_MAX);
+  TMP117_temp tempMin = TempSensor.getTemperature(T_MIN);
+  TMP117_temp tempMax = TempSensor.getTemperature(T_MAX);
   SerialUSB.print("Min/Max temperatures stored in TMP117: Tmin=");
-  SerialUSB.print(tempMin * TMP117_RES, 2);
+  PrintTemperature(tempMin);
   SerialUSB.print(", Tmax=");
-  SerialUSB.print(tempMax * TMP117_RES, 2);
+  PrintTemperature(tempMax);
   SerialUSB.println("°C");
 
 // The first sensor reading after (re-)programming the POR settings will also set the lo/hi values in EEPROM to the measured temperature.
@@ -69,57 +85,56 @@ void setup() {
 }
 
 /**
- * Just looping and waiting, simulating timers and (deep) sleep mode
+ * Handle sensor data, then sleep until next timer or interrupt
  */
-static bool timerOn;
-static bool sleeping;
 void loop() {
-  static uint32_t interval;
+  // (... woke up after interrupt or deadline) read sensors with pending data, check if all sensors ready
+  bool swept = sweep.poll(Clock.now());
 
-  // (... woke up after interrupt) check if all sensors ready
-  if (sensorsServiced == All_sensors(sensorCount)) {
-    // all sensors ready
+  // process the samples the read path has pushed so far
+  TMP117_sample s;
+  while (samples.pop(s)) {
+    temperature = s.temp.raw();
     SerialUSB.print("temperature ");
-    SerialUSB.print(temperature * TMP117_RES, 2);
+    PrintTemperature(s.temp);
     SerialUSB.println("°C");
-    timerOn = false;
   }
-  
-  // do other stuff (or go into sleep mode...)
-  sleeping = true;
-  while (sleeping) {
-    if (millis() - interval > 60 * 1000) {
-      // 'wake up' for next measurement cycle
-      interval = millis();
-      StartTempSensor(); // start next conversion
-    }
 
-    if (timerOn && (millis() - startTime > 200)) { // timeout after 200ms (TMP117 conversion takes 124ms in this example)
-      // 'wake up' after timeout
-      timerOn = false;
-      Error(E_NO_DATA);
-      digitalWrite(LED_BLUE, HIGH); // off
-    }
+  if (swept) {
+    // all sensors ready or missed their deadline
+    digitalWrite(LED_BLUE, HIGH); // off
+    Sampler.update(temperature, Clock.now());
+
+    for (uint8_t i = 0; i < sweep.size(); i++)
+      if (sweep.missed(sweep.sensor(i).sensorId())) {
+        Error(E_NO_DATA);
+        Sampler.reset();
+        break;
+      }
+
+    Events.after(Sampler.interval(), StartTempSensor); // next measurement cycle
   }
+
+  // do other stuff, then sleep
+  Events.run();
 }
 
 /**
- * Start TMP117 temperature conversion
+ * Start TMP117 temperature conversions
  */
 void StartTempSensor(void) {
-  TempSensor.startConversion();
-  startTime = millis();
-  timerOn = true; // start timer
+  sweep.start(Clock.now());
+  Events.after(sweep.deadline() - Clock.now() + 1, nullptr); // wake up after sensor deadline
   digitalWrite(LED_BLUE, LOW); // on
 }
 
 /**
- * TMP117 Data Ready interrupt - read sensor data
+ * Print temperature with 2 decimals (integer only)
  */
-void TempSensorReady(void) {
-  sleeping = false;
-  temperature = TempSensor.readSensor(&sensorsServiced);
-  digitalWrite(LED_BLUE, HIGH); // off
+void PrintTemperature(TMP117_temp t) {
+  char text[8];
+  tmp117Format(text, sizeof(text), t, 2);
+  SerialUSB.print(text);
 }
 
 /**
@@ -135,9 +150,14 @@ void Error(nodeError_t e) {
   
   // other errors
     case E_NO_DATA:
-      SerialUSB.print("No sensor data - error status: ");
-      SerialUSB.println(sensorsServiced ^ All_sensors(sensorCount), BIN);
-      TempSensor.softReset(); // small chance this will solve the problem...
+      SerialUSB.print("No sensor data - missing:");
+      for (uint8_t i = 0; i < sweep.size(); i++)
+        if (sweep.missed(sweep.sensor(i).sensorId())) {
+          SerialUSB.print(" S");
+          SerialUSB.print(sweep.sensor(i).sensorId());
+          sweep.sensor(i).softReset(); // small chance this will solve the problem...
+        }
+      SerialUSB.println();
       break;
   }
 }
\ No newline at end of file